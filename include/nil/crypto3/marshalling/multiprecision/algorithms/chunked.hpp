@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_CHUNKED_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_CHUNKED_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Pull based serializer of a fixed precision values range.
+            /// @details Produces the same bytes as serializing the whole range at once, but only
+            ///     as many of them as the caller asks for on every read() call. Apart from the
+            ///     caller's chunk, only the one value straddling the chunk boundary is buffered, so
+            ///     the memory use does not depend on the range size.
+            /// @tparam TEndian Endianness option, e.g. nil::marshalling::option::big_endian.
+            template<typename TEndian, typename TInputIter>
+            class chunked_serializer {
+                using value_type = typename std::iterator_traits<TInputIter>::value_type;
+
+                static constexpr std::size_t value_length = serialized_length<value_type>::value;
+
+            public:
+                chunked_serializer(TInputIter first, TInputIter last) :
+                    first_(first), last_(last),
+                    total_length_(value_length * static_cast<std::size_t>(std::distance(first, last))) {
+                }
+
+                /// @brief Number of bytes the whole range is serialized into.
+                /// @details Doesn't change as the bytes are read.
+                std::size_t total_length() const {
+                    return total_length_;
+                }
+
+                /// @brief Number of bytes not produced by read() yet.
+                std::size_t remaining_length() const {
+                    return value_length * static_cast<std::size_t>(std::distance(first_, last_)) +
+                           (value_length - pending_offset_);
+                }
+
+                /// @brief Check whether all the bytes were produced.
+                bool done() const {
+                    return first_ == last_ && pending_offset_ == value_length;
+                }
+
+                /// @brief Serialize the next bytes of the range.
+                /// @param[out] out Output area.
+                /// @param[in] size Size of the output area.
+                /// @return Number of bytes written, less than size only at the end of the range.
+                std::size_t read(std::uint8_t *out, std::size_t size) {
+                    std::size_t written = 0;
+
+                    if (pending_offset_ < value_length) {
+                        written = std::min(value_length - pending_offset_, size);
+                        std::copy_n(pending_.begin() + pending_offset_, written, out);
+                        pending_offset_ += written;
+                    }
+
+                    for (; first_ != last_ && size - written >= value_length; ++first_) {
+                        std::uint8_t *iter = out + written;
+                        detail::pack_into<TEndian>(*first_, iter);
+                        written += value_length;
+                    }
+
+                    if (first_ != last_ && written < size) {
+                        auto iter = pending_.begin();
+                        detail::pack_into<TEndian>(*first_, iter);
+                        ++first_;
+
+                        pending_offset_ = size - written;
+                        std::copy_n(pending_.begin(), pending_offset_, out + written);
+                        written = size;
+                    }
+                    return written;
+                }
+
+            private:
+                TInputIter first_;
+                TInputIter last_;
+                std::size_t total_length_;
+                std::array<std::uint8_t, value_length> pending_;
+                std::size_t pending_offset_ = value_length;
+            };
+
+            /// @brief Serialize fixed precision values range chunk by chunk.
+            /// @details A single chunk_size bytes buffer is reused for the whole range.
+            /// @param[in] first Beginning of the values range.
+            /// @param[in] last End of the values range.
+            /// @param[in] chunk_size Size of the chunks, every chunk but the last one is full.
+            /// @param[in] func Callable invoked as func(const std::uint8_t *data, std::size_t size)
+            ///     for every chunk, e.g. writing it to a file or a socket.
+            /// @pre chunk_size > 0
+            template<typename TEndian, typename TInputIter, typename TFunc>
+            void serialize_chunked(TInputIter first, TInputIter last, std::size_t chunk_size, TFunc func) {
+                chunked_serializer<TEndian, TInputIter> serializer(first, last);
+                std::vector<std::uint8_t> chunk(chunk_size);
+
+                while (!serializer.done()) {
+                    std::size_t size = serializer.read(chunk.data(), chunk.size());
+                    func(static_cast<const std::uint8_t *>(chunk.data()), size);
+                }
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_CHUNKED_HPP
@@ -0,0 +1,219 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_CONTEXT_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_CONTEXT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace detail {
+                /// @brief Checks whether the limbs of a backend can be resized and filled in place.
+                template<typename Backend>
+                struct is_resizable_limbs_backend : std::false_type { };
+
+                template<unsigned MinBits, unsigned MaxBits, boost::multiprecision::cpp_integer_type SignType,
+                         boost::multiprecision::cpp_int_check_type Checked, typename Allocator>
+                struct is_resizable_limbs_backend<
+                    boost::multiprecision::backends::cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>>
+                    : std::true_type { };
+            }    // namespace detail
+
+            /// @brief Serialization state reused across calls encoding and decoding values of T.
+            /// @details Encoding writes straight into an output buffer owned by the context instead
+            ///     of building an intermediate array_list and returning a fresh vector, the buffer
+            ///     keeps its capacity between calls. Decoding writes into the existing elements of
+            ///     the destination, so neither fixed precision values nor the limbs of non fixed
+            ///     precision ones are reallocated once they are large enough. Encoding and decoding
+            ///     the same shapes over and over allocates nothing after the first call.
+            ///
+            ///     Vectors are encoded as the array_list made by types::fill_integral_vector(): a
+            ///     std::size_t size prefix followed by the values. They are defined for fixed
+            ///     precision values only, non fixed precision ones carry no length of their own.
+            ///
+            ///     A context is not thread safe, local() gives the calling thread its own one.
+            /// @tparam TEndian Endianness option, e.g. nil::marshalling::option::big_endian.
+            /// @tparam T Multiprecision number type.
+            template<typename TEndian, typename T>
+            class serialization_context;
+
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates>
+            class serialization_context<TEndian, boost::multiprecision::number<Backend, ExpressionTemplates>> {
+            public:
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+                using buffer_type = std::vector<std::uint8_t>;
+                using size_type = std::size_t;
+
+                static constexpr bool is_fixed_precision =
+                    boost::multiprecision::backends::is_fixed_precision<Backend>::value;
+
+                /// @brief Get the context of the calling thread.
+                static serialization_context &local() {
+                    static thread_local serialization_context context;
+                    return context;
+                }
+
+                /// @brief Encode the value into the buffer of the context.
+                /// @return The buffer, valid until the next call to encode().
+                const buffer_type &encode(const value_type &value) {
+                    if constexpr (is_fixed_precision) {
+                        buffer_.resize(serialized_length<value_type>::value);
+                        auto iter = buffer_.begin();
+                        detail::pack_into<TEndian>(value, iter);
+                    } else {
+                        // processing::write_data() takes the value by copy, export the limbs directly
+                        buffer_.resize(processing::length(value));
+                        export_bits(value, buffer_.begin(), 8, is_big_endian);
+                    }
+                    return buffer_;
+                }
+
+                /// @brief Encode the values into the buffer of the context.
+                /// @return The buffer, valid until the next call to encode().
+                const buffer_type &encode(const std::vector<value_type> &values) {
+                    static_assert(is_fixed_precision, "vectors are defined for fixed precision values only");
+
+                    buffer_.resize(sizeof(size_type) + values.size() * serialized_length<value_type>::value);
+                    auto iter = buffer_.begin();
+                    processing::detail::write_word<endian_type>(static_cast<size_type>(values.size()), iter);
+                    detail::pack_range_into<TEndian>(values.data(), values.data() + values.size(), iter);
+                    return buffer_;
+                }
+
+                /// @brief Decode a value reusing the storage of value.
+                /// @details Fixed precision values take serialized_length() bytes, non fixed
+                ///     precision ones take all the size bytes.
+                /// @return not_enough_data if the buffer is too short, the value and the iterator
+                ///     are left unchanged then, success otherwise.
+                /// @post The iterator is advanced past the value.
+                template<typename TIter>
+                nil::marshalling::status_type decode(TIter &iter, std::size_t size, value_type &value) {
+                    if constexpr (is_fixed_precision) {
+                        if (size < serialized_length<value_type>::value) {
+                            return nil::marshalling::status_type::not_enough_data;
+                        }
+                        read_fixed(iter, value);
+                    } else {
+                        TIter last = iter;
+                        std::advance(last, size);
+                        if constexpr (detail::is_resizable_limbs_backend<Backend>::value) {
+                            import_in_place(iter, size, value);
+                        } else {
+                            boost::multiprecision::import_bits(value, iter, last, 8, is_big_endian);
+                        }
+                        iter = last;
+                    }
+                    return nil::marshalling::status_type::success;
+                }
+
+                /// @brief Decode values written by encode() reusing the storage of values.
+                /// @return not_enough_data if the buffer is shorter than the size prefix tells,
+                ///     values and the iterator are left unchanged then, success otherwise.
+                /// @post The iterator is advanced past the values.
+                template<typename TIter>
+                nil::marshalling::status_type decode(TIter &iter, std::size_t size, std::vector<value_type> &values) {
+                    static_assert(is_fixed_precision, "vectors are defined for fixed precision values only");
+
+                    if (size < sizeof(size_type)) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+                    TIter data = iter;
+                    size_type count = processing::detail::read_word<endian_type, size_type>(data);
+                    if (count > (size - sizeof(size_type)) / serialized_length<value_type>::value) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+
+                    values.resize(count);
+                    detail::unpack_range_from<TEndian>(data, values.data(), values.data() + values.size());
+                    iter = data;
+                    return nil::marshalling::status_type::success;
+                }
+
+                /// @brief Release the memory held by the context.
+                void shrink_to_fit() {
+                    buffer_type().swap(buffer_);
+                }
+
+            private:
+                using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+
+                static constexpr bool is_big_endian =
+                    std::is_same<endian_type, nil::marshalling::endian::big_endian>::value;
+
+                template<typename TIter>
+                static void read_fixed(TIter &iter, value_type &value) {
+                    types::integral<nil::marshalling::field_type<TEndian>, value_type> field;
+                    field.read(iter, serialized_length<value_type>::value);
+                    value = field.value();
+                }
+
+                /// @brief Same as import_bits() but keeps the limbs allocation of value.
+                /// @details import_bits() builds the result in a new backend and swaps it in.
+                template<typename TIter>
+                static void import_in_place(TIter iter, std::size_t size, value_type &value) {
+                    Backend &backend = value.backend();
+                    using limb_type = typename std::remove_pointer<decltype(backend.limbs())>::type;
+
+                    constexpr std::size_t limb_bytes = sizeof(limb_type);
+                    std::size_t limbs_count =
+                        std::max<std::size_t>(size / limb_bytes + ((size % limb_bytes) ? 1 : 0), 1);
+                    backend.resize(static_cast<unsigned>(limbs_count), static_cast<unsigned>(limbs_count));
+                    limb_type *limbs = backend.limbs();
+                    std::fill(limbs, limbs + backend.size(), limb_type(0));
+
+                    for (std::size_t i = 0; i < size; ++i, ++iter) {
+                        std::size_t byte_index = is_big_endian ? size - 1 - i : i;
+                        limbs[byte_index / limb_bytes] |= static_cast<limb_type>(static_cast<std::uint8_t>(*iter))
+                                                          << ((byte_index % limb_bytes) * 8);
+                    }
+                    backend.sign(false);
+                    backend.normalize();
+                }
+
+                buffer_type buffer_;
+            };
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_CONTEXT_HPP
@@ -0,0 +1,234 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_DELTA_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_DELTA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Word the sizes and run bounds of the delta are stored in.
+            using delta_word_type = std::uint64_t;
+
+            namespace detail {
+                /// @brief Run of changed elements: index of the first one and the count.
+                using delta_run = std::pair<std::size_t, std::size_t>;
+
+                /// @brief Find the runs of elements of updated which differ from base.
+                /// @details Elements past the end of base are always included. Runs separated by
+                ///     fewer unchanged elements than a run header takes are merged, re-sending the
+                ///     unchanged elements is cheaper then.
+                template<typename T>
+                std::vector<delta_run> delta_runs(const std::vector<T> &base, const std::vector<T> &updated) {
+                    constexpr std::size_t max_gap = 2 * sizeof(delta_word_type) / serialized_length<T>::value;
+
+                    std::vector<delta_run> runs;
+                    for (std::size_t i = 0; i < updated.size(); ++i) {
+                        if (i < base.size() && base[i] == updated[i]) {
+                            continue;
+                        }
+                        if (!runs.empty() && i - (runs.back().first + runs.back().second) <= max_gap) {
+                            runs.back().second = i + 1 - runs.back().first;
+                        } else {
+                            runs.emplace_back(i, 1);
+                        }
+                    }
+                    return runs;
+                }
+
+                template<typename T>
+                std::size_t delta_length(const std::vector<delta_run> &runs) {
+                    std::size_t result = 2 * sizeof(delta_word_type);
+                    for (const delta_run &run : runs) {
+                        result += 2 * sizeof(delta_word_type) + run.second * serialized_length<T>::value;
+                    }
+                    return result;
+                }
+            }    // namespace detail
+
+            /// @brief Number of bytes the delta between base and updated takes.
+            template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+            std::size_t
+                delta_length(const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &base,
+                             const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &updated) {
+                return detail::delta_length<boost::multiprecision::number<Backend, ExpressionTemplates>>(
+                    detail::delta_runs(base, updated));
+            }
+
+            /// @brief Write the delta turning base into updated.
+            /// @details The layout is the size of updated, the number of runs and then every run:
+            ///     index of its first element, number of elements and the new element values
+            ///     encoded as by the fixed precision integral. Sizes and run bounds are 64 bit
+            ///     words in the same endianness as the values. Only the changed elements (and the
+            ///     ones appended past the end of base) are written, so a delta of two mostly equal
+            ///     vectors is a small fraction of the full encoding.
+            /// @tparam TEndian Endianness option, e.g. nil::marshalling::option::big_endian.
+            /// @param[in] base Vector the receiver already has.
+            /// @param[in] updated New version of the vector.
+            /// @param[in, out] iter Random access output iterator.
+            /// @param[in] size Number of bytes available for writing.
+            /// @return buffer_overflow if the delta doesn't fit, nothing is written then,
+            ///     success otherwise.
+            /// @post The iterator is advanced past the delta.
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates, typename TIter>
+            nil::marshalling::status_type
+                write_delta(const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &base,
+                            const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &updated,
+                            TIter &iter, std::size_t size) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+                using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+
+                static_assert(boost::multiprecision::backends::is_fixed_precision<Backend>::value,
+                              "delta encoding is defined for fixed precision values only");
+
+                std::vector<detail::delta_run> runs = detail::delta_runs(base, updated);
+                if (size < detail::delta_length<value_type>(runs)) {
+                    return nil::marshalling::status_type::buffer_overflow;
+                }
+
+                processing::detail::write_word<endian_type>(static_cast<delta_word_type>(updated.size()), iter);
+                processing::detail::write_word<endian_type>(static_cast<delta_word_type>(runs.size()), iter);
+                for (const detail::delta_run &run : runs) {
+                    processing::detail::write_word<endian_type>(static_cast<delta_word_type>(run.first), iter);
+                    processing::detail::write_word<endian_type>(static_cast<delta_word_type>(run.second), iter);
+                    for (std::size_t i = run.first; i < run.first + run.second; ++i) {
+                        detail::pack_into<TEndian>(updated[i], iter);
+                    }
+                }
+                return nil::marshalling::status_type::success;
+            }
+
+            /// @brief Encode the delta turning base into updated into a new buffer.
+            /// @see write_delta()
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates>
+            std::vector<std::uint8_t>
+                encode_delta(const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &base,
+                             const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &updated) {
+                std::vector<std::uint8_t> result(delta_length(base, updated));
+                auto iter = result.begin();
+                write_delta<TEndian>(base, updated, iter, result.size());
+                return result;
+            }
+
+            /// @brief Apply the delta written by write_delta() to the base vector in place.
+            /// @details The whole delta is validated before values is touched: runs must be
+            ///     ordered, lie within the updated size, cover every element past the end of
+            ///     values and their payloads must fit into the buffer. Then values is resized and
+            ///     only the elements of the runs are decoded.
+            /// @tparam TEndian Endianness option the delta was written with.
+            /// @param[in, out] iter Random access input iterator.
+            /// @param[in] size Number of bytes available for reading.
+            /// @param[in, out] values The base vector, turned into the updated one.
+            /// @return not_enough_data if the buffer is shorter than the delta, invalid_msg_data if
+            ///     the delta doesn't apply to a vector of values.size() elements, success
+            ///     otherwise. On failure neither values nor the iterator are changed.
+            /// @post The iterator is advanced past the delta.
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates, typename TIter>
+            nil::marshalling::status_type
+                apply_delta(TIter &iter, std::size_t size,
+                            std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+                using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+                using integral_type = types::integral<nil::marshalling::field_type<TEndian>, value_type>;
+
+                constexpr std::size_t value_length = serialized_length<value_type>::value;
+                constexpr std::size_t header_length = 2 * sizeof(delta_word_type);
+
+                if (size < header_length) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+                TIter data = iter;
+                delta_word_type updated_size = processing::detail::read_word<endian_type, delta_word_type>(data);
+                delta_word_type runs_count = processing::detail::read_word<endian_type, delta_word_type>(data);
+                std::size_t available = size - header_length;
+
+                std::vector<detail::delta_run> runs;
+                runs.reserve(
+                    static_cast<std::size_t>(std::min<delta_word_type>(runs_count, available / header_length)));
+                delta_word_type covered = 0;
+                for (delta_word_type i = 0; i < runs_count; ++i) {
+                    if (available < header_length) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+                    delta_word_type first = processing::detail::read_word<endian_type, delta_word_type>(data);
+                    delta_word_type count = processing::detail::read_word<endian_type, delta_word_type>(data);
+                    available -= header_length;
+
+                    if (first < covered || count == 0 || count > updated_size || first > updated_size - count ||
+                        (first > covered && first > values.size())) {
+                        return nil::marshalling::status_type::invalid_msg_data;
+                    }
+                    if (count > available / value_length) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+                    available -= static_cast<std::size_t>(count) * value_length;
+                    data += static_cast<std::ptrdiff_t>(count * value_length);
+
+                    runs.emplace_back(static_cast<std::size_t>(first), static_cast<std::size_t>(count));
+                    covered = first + count;
+                }
+                if (covered < updated_size && updated_size > values.size()) {
+                    return nil::marshalling::status_type::invalid_msg_data;
+                }
+
+                values.resize(static_cast<std::size_t>(updated_size));
+                TIter payload = iter;
+                std::advance(payload, header_length);
+                for (const detail::delta_run &run : runs) {
+                    std::advance(payload, header_length);
+                    for (std::size_t i = run.first; i < run.first + run.second; ++i) {
+                        integral_type field;
+                        field.read(payload, value_length);
+                        values[i] = field.value();
+                    }
+                }
+
+                iter = payload;
+                return nil::marshalling::status_type::success;
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_DELTA_HPP
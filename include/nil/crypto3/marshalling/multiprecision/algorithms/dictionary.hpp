@@ -0,0 +1,302 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_DICTIONARY_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_DICTIONARY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/endianness.hpp>
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/bit_packed.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Word the values count and the dictionary size are stored in.
+            using dictionary_count_type = std::uint64_t;
+
+            /// @brief Type the dictionary indices are decoded into.
+            using dictionary_index_type = std::uint32_t;
+
+            namespace detail {
+                /// @brief Hash of the limbs of a fixed precision value.
+                /// @details Every limb is mixed in with a multiply-xorshift step, no bytes are
+                ///     serialized to compute it.
+                template<typename T>
+                struct limbs_hash {
+                    std::size_t operator()(const T &value) const {
+                        using traits = processing::detail::limb_traits<T>;
+
+                        const typename traits::limb_type *limbs = traits::limbs(value);
+                        std::uint64_t result = 0;
+                        for (std::size_t i = 0; i < traits::limb_count; ++i) {
+                            result = (result ^ static_cast<std::uint64_t>(limbs[i])) * 0x9e3779b97f4a7c15ULL;
+                            result ^= result >> 32;
+                        }
+                        return static_cast<std::size_t>(result);
+                    }
+                };
+
+                /// @brief Distinct values in the order of their first occurrence and the index of
+                ///     every value in them.
+                template<typename T>
+                struct dictionary {
+                    std::vector<const T *> values;
+                    std::vector<dictionary_index_type> indices;
+                };
+
+                template<typename T>
+                dictionary<T> build_dictionary(const std::vector<T> &values) {
+                    dictionary<T> result;
+                    result.indices.reserve(values.size());
+
+                    std::unordered_map<T, dictionary_index_type, limbs_hash<T>> lookup;
+                    for (const T &value : values) {
+                        auto inserted =
+                            lookup.emplace(value, static_cast<dictionary_index_type>(result.values.size()));
+                        if (inserted.second) {
+                            result.values.push_back(&value);
+                        }
+                        result.indices.push_back(inserted.first->second);
+                    }
+                    return result;
+                }
+
+                /// @brief Number of bits every index takes for the dictionary of the given size.
+                /// @details At least one, so that the input size bounds the values count also for
+                ///     a single entry dictionary.
+                inline std::size_t dictionary_index_bits(std::size_t dictionary_size) {
+                    std::size_t result = 1;
+                    while (result < 32 && (std::size_t(1) << result) < dictionary_size) {
+                        ++result;
+                    }
+                    return result;
+                }
+
+                template<typename T>
+                std::size_t dictionary_length(std::size_t count, std::size_t dictionary_size) {
+                    return 2 * sizeof(dictionary_count_type) + dictionary_size * serialized_length<T>::value +
+                           (count * dictionary_index_bits(dictionary_size) + 7) / 8;
+                }
+
+                template<typename TEndian, typename T, typename TIter>
+                void write_dictionary(const dictionary<T> &dictionary, TIter &iter) {
+                    using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+
+                    processing::detail::write_word<endian_type>(
+                        static_cast<dictionary_count_type>(dictionary.indices.size()), iter);
+                    processing::detail::write_word<endian_type>(
+                        static_cast<dictionary_count_type>(dictionary.values.size()), iter);
+                    for (const T *value : dictionary.values) {
+                        pack_into<TEndian>(*value, iter);
+                    }
+
+                    std::size_t index_bits = dictionary_index_bits(dictionary.values.size());
+                    processing::detail::bit_stream_writer<TIter> writer(iter);
+                    for (dictionary_index_type index : dictionary.indices) {
+                        writer.put(index, index_bits);
+                    }
+                    writer.flush();
+                }
+            }    // namespace detail
+
+            /// @brief Number of bytes the values take in the dictionary encoding.
+            template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+            std::size_t dictionary_length(
+                const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+
+                std::unordered_map<value_type, bool, detail::limbs_hash<value_type>> lookup;
+                for (const value_type &value : values) {
+                    lookup.emplace(value, true);
+                }
+                return detail::dictionary_length<value_type>(values.size(), lookup.size());
+            }
+
+            /// @brief Write the values as a dictionary of the distinct ones plus an index per value.
+            /// @details The layout is the values count and the dictionary size as 64 bit words in
+            ///     the values endianness, the distinct values in the order of their first
+            ///     occurrence encoded as by the fixed precision integral, and then the indices
+            ///     packed back to back, least significant bit first, each taking
+            ///     max(ceil(log2(dictionary size)), 1) bits. The
+            ///     dictionary is built with a hash of the limbs, so a vector of a few distinct
+            ///     values is encoded in a single pass and shrinks to a few bits per value.
+            /// @tparam TEndian Endianness option, e.g. nil::marshalling::option::big_endian.
+            /// @param[in] values Values to write.
+            /// @param[in, out] iter Output iterator.
+            /// @param[in] size Number of bytes available for writing.
+            /// @return buffer_overflow if the encoding doesn't fit, nothing is written then,
+            ///     success otherwise.
+            /// @post The iterator is advanced past the encoding.
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates, typename TIter>
+            nil::marshalling::status_type
+                write_dictionary(const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values,
+                                 TIter &iter, std::size_t size) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+
+                static_assert(processing::detail::limb_traits<value_type>::is_specialized,
+                              "dictionary encoding requires direct limb access");
+
+                detail::dictionary<value_type> dictionary = detail::build_dictionary(values);
+                if (size < detail::dictionary_length<value_type>(values.size(), dictionary.values.size())) {
+                    return nil::marshalling::status_type::buffer_overflow;
+                }
+
+                detail::write_dictionary<TEndian>(dictionary, iter);
+                return nil::marshalling::status_type::success;
+            }
+
+            /// @brief Encode the values in the dictionary encoding into a new buffer.
+            /// @see write_dictionary()
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates>
+            std::vector<std::uint8_t> encode_dictionary(
+                const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+
+                static_assert(processing::detail::limb_traits<value_type>::is_specialized,
+                              "dictionary encoding requires direct limb access");
+
+                // The dictionary is built once, unlike going through dictionary_length()
+                detail::dictionary<value_type> dictionary = detail::build_dictionary(values);
+                std::vector<std::uint8_t> result(
+                    detail::dictionary_length<value_type>(values.size(), dictionary.values.size()));
+
+                auto iter = result.begin();
+                detail::write_dictionary<TEndian>(dictionary, iter);
+                return result;
+            }
+
+            /// @brief Read values written by write_dictionary().
+            /// @details The dictionary is decoded once. The indices are then unpacked a block at
+            ///     a time with a branch free loop reading an unaligned 64 bit window per index,
+            ///     checked against the dictionary size and expanded by copying the dictionary
+            ///     values.
+            /// @tparam TEndian Endianness option the values were written with.
+            /// @param[in, out] iter Random access input iterator.
+            /// @param[in] size Number of bytes available for reading.
+            /// @param[out] values Decoded values, resized to the stored count.
+            /// @return not_enough_data if the buffer is shorter than the encoding, invalid_msg_data
+            ///     if an index or the dictionary size is out of range, success otherwise. On
+            ///     failure neither values nor the iterator are changed.
+            /// @post The iterator is advanced past the encoding.
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates, typename TIter>
+            nil::marshalling::status_type
+                read_dictionary(TIter &iter, std::size_t size,
+                                std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+                using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+                using integral_type = types::integral<nil::marshalling::field_type<TEndian>, value_type>;
+
+                constexpr std::size_t value_length = serialized_length<value_type>::value;
+                constexpr std::size_t block_size = 256;
+
+                if (size < 2 * sizeof(dictionary_count_type)) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+                TIter data = iter;
+                dictionary_count_type count = processing::detail::read_word<endian_type, dictionary_count_type>(data);
+                dictionary_count_type dictionary_size =
+                    processing::detail::read_word<endian_type, dictionary_count_type>(data);
+                size -= 2 * sizeof(dictionary_count_type);
+
+                if (dictionary_size > count || (count && !dictionary_size) ||
+                    dictionary_size > (dictionary_count_type(1) << 32)) {
+                    return nil::marshalling::status_type::invalid_msg_data;
+                }
+                if (dictionary_size > size / value_length) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+                size -= static_cast<std::size_t>(dictionary_size) * value_length;
+
+                std::size_t index_bits = detail::dictionary_index_bits(static_cast<std::size_t>(dictionary_size));
+                // Checked before the values are allocated
+                if (count > size * 8 / index_bits) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+                std::size_t indices_length = (static_cast<std::size_t>(count) * index_bits + 7) / 8;
+
+                std::vector<value_type> dictionary(static_cast<std::size_t>(dictionary_size));
+                for (value_type &value : dictionary) {
+                    integral_type field;
+                    field.read(data, value_length);
+                    value = field.value();
+                }
+
+                // Padded so that the 64 bit window of the last index stays within the buffer
+                std::vector<std::uint8_t> packed(indices_length + sizeof(std::uint64_t), 0);
+                std::copy(data, data + static_cast<std::ptrdiff_t>(indices_length), packed.begin());
+
+                std::vector<value_type> result(static_cast<std::size_t>(count));
+                std::uint64_t mask = (std::uint64_t(1) << index_bits) - 1;
+                std::array<dictionary_index_type, block_size> indices;
+                for (std::size_t begin = 0; begin < result.size(); begin += block_size) {
+                    std::size_t end = std::min(result.size(), begin + block_size);
+
+                    dictionary_index_type max_index = 0;
+                    for (std::size_t i = begin; i < end; ++i) {
+                        std::size_t position = i * index_bits;
+                        const std::uint8_t *window = packed.data() + position / 8;
+                        std::uint64_t word =
+                            processing::detail::read_word<nil::marshalling::endian::little_endian, std::uint64_t>(
+                                window);
+                        indices[i - begin] = static_cast<dictionary_index_type>((word >> (position % 8)) & mask);
+                        max_index = std::max(max_index, indices[i - begin]);
+                    }
+                    if (max_index >= dictionary_size) {
+                        return nil::marshalling::status_type::invalid_msg_data;
+                    }
+
+                    for (std::size_t i = begin; i < end; ++i) {
+                        result[i] = dictionary[indices[i - begin]];
+                    }
+                }
+
+                values = std::move(result);
+                iter = data + static_cast<std::ptrdiff_t>(indices_length);
+                return nil::marshalling::status_type::success;
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_DICTIONARY_HPP
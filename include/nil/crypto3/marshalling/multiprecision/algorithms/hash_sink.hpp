@@ -0,0 +1,233 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_HASH_SINK_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_HASH_SINK_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/types/array_list.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Output sink streaming serialized data into an absorbing (hash or transcript) state.
+            /// @details Units are collected in an on-stack block buffer and handed over to the absorber
+            ///     every time the block is full, so the full encoding of absorbed fields is never
+            ///     materialized.
+            /// @tparam TAbsorber Callable invoked as absorber(const std::uint8_t *data, std::size_t size).
+            /// @tparam BlockSize Size of the block buffer in bytes.
+            ///     @code
+            ///         auto sink = hash_sink([&](const std::uint8_t *data, std::size_t size) {
+            ///             state.update(data, size);
+            ///         });
+            ///         absorb(sink, field);
+            ///         sink.flush();
+            ///     @endcode
+            template<typename TAbsorber, std::size_t BlockSize = 64>
+            class hash_sink {
+                static_assert(BlockSize > 0, "block size must be positive");
+
+            public:
+                /// @brief Output iterator putting the assigned bytes into the sink.
+                class iterator {
+                public:
+                    using iterator_category = std::output_iterator_tag;
+                    using value_type = std::uint8_t;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = void;
+                    using reference = void;
+
+                    explicit iterator(hash_sink &sink) : sink_(&sink) {
+                    }
+
+                    iterator &operator=(std::uint8_t unit) {
+                        sink_->put(unit);
+                        return *this;
+                    }
+
+                    iterator &operator*() {
+                        return *this;
+                    }
+
+                    iterator &operator++() {
+                        return *this;
+                    }
+
+                    iterator operator++(int) {
+                        return *this;
+                    }
+
+                private:
+                    hash_sink *sink_;
+                };
+
+                explicit hash_sink(TAbsorber absorber) : absorber_(std::move(absorber)) {
+                }
+
+                hash_sink(const hash_sink &) = delete;
+
+                hash_sink &operator=(const hash_sink &) = delete;
+
+                /// @brief Get output iterator writing into the sink.
+                iterator begin() {
+                    return iterator(*this);
+                }
+
+                /// @brief Put single byte into the sink.
+                void put(std::uint8_t unit) {
+                    buffer_[size_++] = unit;
+                    if (size_ == BlockSize) {
+                        flush();
+                    }
+                }
+
+                /// @brief Put sequence of bytes into the sink.
+                void put(const std::uint8_t *data, std::size_t size) {
+                    while (size > 0) {
+                        std::size_t count = std::min(size, BlockSize - size_);
+                        std::copy(data, data + count, buffer_.begin() + size_);
+                        size_ += count;
+                        data += count;
+                        size -= count;
+                        if (size_ == BlockSize) {
+                            flush();
+                        }
+                    }
+                }
+
+                /// @brief Hand the buffered bytes over to the absorber.
+                /// @details Must be called once all the fields were absorbed, the sink doesn't
+                ///     flush on destruction.
+                void flush() {
+                    if (size_ > 0) {
+                        absorber_(static_cast<const std::uint8_t *>(buffer_.data()), size_);
+                        size_ = 0;
+                    }
+                }
+
+                /// @brief Get access to the absorber.
+                TAbsorber &absorber() {
+                    return absorber_;
+                }
+
+            private:
+                TAbsorber absorber_;
+                std::array<std::uint8_t, BlockSize> buffer_;
+                std::size_t size_ = 0;
+            };
+
+            /// @brief Serialize integral field straight into the sink.
+            /// @details Produces exactly the same bytes as write() of the field would.
+            /// @related hash_sink
+            template<typename TAbsorber,
+                     std::size_t BlockSize,
+                     typename TTypeBase,
+                     typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates,
+                     typename... TOptions>
+            void absorb(
+                hash_sink<TAbsorber, BlockSize> &sink,
+                const types::integral<TTypeBase, boost::multiprecision::number<Backend, ExpressionTemplates>, TOptions...>
+                    &field) {
+
+                using field_type =
+                    types::integral<TTypeBase, boost::multiprecision::number<Backend, ExpressionTemplates>, TOptions...>;
+                using iterator = typename hash_sink<TAbsorber, BlockSize>::iterator;
+
+                auto iter = sink.begin();
+
+                if constexpr (!boost::multiprecision::backends::is_fixed_precision<Backend>::value ||
+                              processing::detail::is_limb_kernel_applicable<typename field_type::value_type,
+                                                                            iterator>::value) {
+                    // both encodings write units strictly one after another
+                    field.write_no_status(iter);
+                } else {
+                    std::array<std::uint8_t, field_type::max_length()> buffer;
+                    auto buffer_iter = buffer.begin();
+                    field.write_no_status(buffer_iter);
+                    sink.put(buffer.data(), buffer.size());
+                }
+            }
+
+            /// @brief Serialize container of integral fields straight into the sink.
+            /// @details The size prefix (if any) is absorbed first, then all the elements.
+            /// @related hash_sink
+            template<typename TAbsorber,
+                     std::size_t BlockSize,
+                     typename TTypeBase,
+                     typename TElementTypeBase,
+                     typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates,
+                     typename... TElementOptions,
+                     typename... TOptions>
+            void absorb(hash_sink<TAbsorber, BlockSize> &sink,
+                        const nil::marshalling::types::array_list<
+                            TTypeBase,
+                            types::integral<TElementTypeBase,
+                                            boost::multiprecision::number<Backend, ExpressionTemplates>,
+                                            TElementOptions...>,
+                            TOptions...> &field) {
+
+                using parsed_options_type = typename std::decay<decltype(field)>::type::parsed_options_type;
+
+                static_assert(!parsed_options_type::has_sequence_ser_length_field_prefix,
+                              "nil::marshalling::option::sequence_ser_length_field_prefix option is not supported");
+                static_assert(
+                    !parsed_options_type::has_sequence_elem_ser_length_field_prefix &&
+                        !parsed_options_type::has_sequence_elem_fixed_ser_length_field_prefix,
+                    "nil::marshalling::option::sequence_elem_ser_length_field_prefix option is not supported");
+                static_assert(!parsed_options_type::has_sequence_trailing_field_suffix &&
+                                  !parsed_options_type::has_sequence_termination_field_suffix,
+                              "sequence suffix options are not supported");
+
+                if constexpr (parsed_options_type::has_sequence_size_field_prefix) {
+                    using size_field_type = typename parsed_options_type::sequence_size_field_prefix;
+                    using size_value_type = typename size_field_type::value_type;
+
+                    size_field_type size_field(static_cast<size_value_type>(field.value().size()));
+                    auto iter = sink.begin();
+                    size_field.write_no_status(iter);
+                }
+
+                for (const auto &element : field.value()) {
+                    absorb(sink, element);
+                }
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_HASH_SINK_HPP
@@ -0,0 +1,279 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_HEX_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_HEX_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace detail {
+                template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+                using hex_integral_type =
+                    types::integral<nil::marshalling::field_type<nil::marshalling::option::big_endian>,
+                                    boost::multiprecision::number<Backend, ExpressionTemplates>>;
+
+                template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+                using hex_basic_integral_type =
+                    types::detail::basic_integral<nil::marshalling::field_type<nil::marshalling::option::big_endian>,
+                                                  Backend, ExpressionTemplates>;
+
+                constexpr std::uint8_t invalid_hex_digit = 0xFF;
+
+                constexpr std::array<std::uint8_t, 256> make_hex_decode_table() {
+                    std::array<std::uint8_t, 256> table {};
+                    for (std::size_t i = 0; i < table.size(); ++i) {
+                        table[i] = invalid_hex_digit;
+                    }
+                    for (std::uint8_t i = 0; i < 10; ++i) {
+                        table['0' + i] = i;
+                    }
+                    for (std::uint8_t i = 0; i < 6; ++i) {
+                        table['a' + i] = 10 + i;
+                        table['A' + i] = 10 + i;
+                    }
+                    return table;
+                }
+
+                /// @brief Nibble values of the characters, invalid_hex_digit for the non hex digits.
+                inline constexpr std::array<std::uint8_t, 256> hex_decode_table = make_hex_decode_table();
+
+                inline constexpr char hex_digits[] = "0123456789abcdef";
+
+                /// @brief Write two lower case hex digits per byte.
+                /// @details With SSSE3 available 16 bytes are encoded at once, both nibbles of every
+                ///     byte are translated to digits with a single pshufb table lookup.
+                /// @return Pointer past the last written digit.
+                inline char *encode_hex_bytes(const std::uint8_t *data, std::size_t size, char *out) {
+#if defined(__SSSE3__)
+                    const __m128i table =
+                        _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+                    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+
+                    for (; size >= 16; size -= 16, data += 16, out += 32) {
+                        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+                        __m128i high =
+                            _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask));
+                        __m128i low = _mm_shuffle_epi8(table, _mm_and_si128(bytes, nibble_mask));
+
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(high, low));
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), _mm_unpackhi_epi8(high, low));
+                    }
+#endif
+                    for (std::size_t i = 0; i < size; ++i) {
+                        *out++ = hex_digits[data[i] >> 4];
+                        *out++ = hex_digits[data[i] & 0x0F];
+                    }
+                    return out;
+                }
+
+                /// @brief Convert hex digits into (size + 1) / 2 bytes, odd number of digits is
+                ///     treated as having an extra leading zero.
+                /// @return false if any of the characters is not a hex digit.
+                inline bool decode_hex_digits(const char *str, std::size_t size, std::uint8_t *out) {
+                    std::uint8_t invalid = 0;
+
+                    if (size % 2) {
+                        std::uint8_t low = hex_decode_table[static_cast<unsigned char>(*str++)];
+                        invalid |= low;
+                        *out++ = low;
+                        --size;
+                    }
+                    for (; size; size -= 2, str += 2) {
+                        std::uint8_t high = hex_decode_table[static_cast<unsigned char>(str[0])];
+                        std::uint8_t low = hex_decode_table[static_cast<unsigned char>(str[1])];
+                        invalid |= high | low;
+                        *out++ = static_cast<std::uint8_t>((high << 4) | (low & 0x0F));
+                    }
+                    // Valid nibbles never have the upper bits set
+                    return !(invalid & 0xF0);
+                }
+            }    // namespace detail
+
+            /// @brief Get number of hex digits the value is encoded into.
+            /// @details Follows the binary integral encoding: fixed precision values always take
+            ///     2 * max_length() digits (leading zeroes included), other values take the digits
+            ///     of their minimal length encoding.
+            template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+            std::size_t hex_length(const boost::multiprecision::number<Backend, ExpressionTemplates> &value) {
+                using integral_type = detail::hex_integral_type<Backend, ExpressionTemplates>;
+
+                return 2 * integral_type(value).length();
+            }
+
+            /// @brief Encode value as lower case big endian hex digits, without prefix.
+            /// @param[in] value Value to encode.
+            /// @param[out] out Output area of at least hex_length(value) characters.
+            /// @return Pointer past the last written digit.
+            template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+            char *encode_hex(const boost::multiprecision::number<Backend, ExpressionTemplates> &value, char *out) {
+                using integral_type = detail::hex_integral_type<Backend, ExpressionTemplates>;
+
+                integral_type field(value);
+                if constexpr (boost::multiprecision::backends::is_fixed_precision<Backend>::value) {
+                    using basic_integral_type = detail::hex_basic_integral_type<Backend, ExpressionTemplates>;
+
+                    std::array<std::uint8_t, basic_integral_type::max_length()> bytes;
+                    auto iter = bytes.begin();
+                    field.write_no_status(iter);
+                    return detail::encode_hex_bytes(bytes.data(), bytes.size(), out);
+                } else {
+                    std::vector<std::uint8_t> bytes(field.length());
+                    auto iter = bytes.begin();
+                    field.write_no_status(iter);
+                    return detail::encode_hex_bytes(bytes.data(), bytes.size(), out);
+                }
+            }
+
+            /// @brief Encode value as lower case big endian hex string, without prefix.
+            template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+            std::string encode_hex(const boost::multiprecision::number<Backend, ExpressionTemplates> &value) {
+                std::string result(hex_length(value), '0');
+                encode_hex(value, &result[0]);
+                return result;
+            }
+
+            /// @brief Encode every value of the range as a separate hex string.
+            /// @param[out] out Output iterator accepting std::string.
+            /// @return Output iterator past the last written string.
+            template<typename TInputIter, typename TOutputIter>
+            TOutputIter encode_hex(TInputIter first, TInputIter last, TOutputIter out) {
+                for (; first != last; ++first, ++out) {
+                    *out = encode_hex(*first);
+                }
+                return out;
+            }
+
+            /// @brief Decode big endian hex digits into the value.
+            /// @details Both letter cases and an optional "0x" prefix are accepted. Leading zeroes
+            ///     may be omitted or added, so both fixed width and minimal width strings are
+            ///     read back.
+            /// @param[in] str Hex digits.
+            /// @param[in] size Number of characters.
+            /// @param[out] value Decoded value, untouched on failure.
+            /// @return invalid_msg_data if the string is empty, contains non hex digit characters
+            ///     or encodes a value wider than the fixed precision type, success otherwise.
+            template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+            nil::marshalling::status_type
+                decode_hex(const char *str, std::size_t size,
+                           boost::multiprecision::number<Backend, ExpressionTemplates> &value) {
+                using integral_type = detail::hex_integral_type<Backend, ExpressionTemplates>;
+
+                if (size >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+                    str += 2;
+                    size -= 2;
+                }
+                if (!size) {
+                    return nil::marshalling::status_type::invalid_msg_data;
+                }
+                while (size > 1 && *str == '0') {
+                    ++str;
+                    --size;
+                }
+
+                std::size_t bytes_count = (size + 1) / 2;
+                integral_type field;
+                nil::marshalling::status_type status;
+                if constexpr (boost::multiprecision::backends::is_fixed_precision<Backend>::value) {
+                    using basic_integral_type = detail::hex_basic_integral_type<Backend, ExpressionTemplates>;
+
+                    constexpr std::size_t max_length = basic_integral_type::max_length();
+                    constexpr std::size_t top_bits = basic_integral_type::max_bit_length() % 8;
+
+                    if (bytes_count > max_length) {
+                        return nil::marshalling::status_type::invalid_msg_data;
+                    }
+
+                    std::array<std::uint8_t, max_length> bytes {};
+                    if (!detail::decode_hex_digits(str, size, bytes.data() + max_length - bytes_count)) {
+                        return nil::marshalling::status_type::invalid_msg_data;
+                    }
+                    if (top_bits && (bytes[0] >> top_bits)) {
+                        return nil::marshalling::status_type::invalid_msg_data;
+                    }
+
+                    auto iter = bytes.cbegin();
+                    status = field.read(iter, bytes.size());
+                } else {
+                    std::vector<std::uint8_t> bytes(bytes_count);
+                    if (!detail::decode_hex_digits(str, size, bytes.data())) {
+                        return nil::marshalling::status_type::invalid_msg_data;
+                    }
+
+                    auto iter = bytes.cbegin();
+                    status = field.read(iter, bytes.size());
+                }
+
+                if (status == nil::marshalling::status_type::success) {
+                    value = field.value();
+                }
+                return status;
+            }
+
+            /// @brief Decode big endian hex string into the value.
+            template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+            nil::marshalling::status_type
+                decode_hex(std::string_view str, boost::multiprecision::number<Backend, ExpressionTemplates> &value) {
+                return decode_hex(str.data(), str.size(), value);
+            }
+
+            /// @brief Decode every hex string of the range.
+            /// @param[in] first, last Range of values convertible to std::string_view.
+            /// @param[out] out Output iterator to the decoded values, must be valid for
+            ///     std::distance(first, last) values.
+            /// @return Status of the first failed string, success if all of them were decoded.
+            template<typename TInputIter, typename TOutputIter>
+            nil::marshalling::status_type decode_hex(TInputIter first, TInputIter last, TOutputIter out) {
+                for (; first != last; ++first, ++out) {
+                    nil::marshalling::status_type status = decode_hex(std::string_view(*first), *out);
+                    if (status != nil::marshalling::status_type::success) {
+                        return status;
+                    }
+                }
+                return nil::marshalling::status_type::success;
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_HEX_HPP
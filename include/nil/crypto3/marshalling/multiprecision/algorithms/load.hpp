@@ -0,0 +1,290 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_LOAD_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_LOAD_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CRYPTO3_MARSHALLING_LOAD_PREAD
+#else
+#include <fstream>
+#endif
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/parallel.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Default number of bytes read from the file at once.
+            constexpr std::size_t default_load_block_size = std::size_t(1) << 20;
+
+            /// @brief Default number of blocks in flight.
+            constexpr std::size_t default_load_ring_size = 4;
+
+            namespace detail {
+                /// @brief Read-only file read at explicit offsets.
+                /// @details Uses pread on POSIX systems, so reads never move a shared file position.
+                ///     Elsewhere falls back to seeking a stream, which is fine as long as only one
+                ///     thread reads.
+                class load_file_reader {
+                public:
+                    explicit load_file_reader(const std::string &path) {
+#ifdef CRYPTO3_MARSHALLING_LOAD_PREAD
+                        fd_ = ::open(path.c_str(), O_RDONLY);
+#else
+                        stream_.open(path, std::ios::binary);
+#endif
+                    }
+
+                    load_file_reader(const load_file_reader &) = delete;
+                    load_file_reader &operator=(const load_file_reader &) = delete;
+
+                    ~load_file_reader() {
+#ifdef CRYPTO3_MARSHALLING_LOAD_PREAD
+                        if (fd_ >= 0) {
+                            ::close(fd_);
+                        }
+#endif
+                    }
+
+                    bool is_open() const {
+#ifdef CRYPTO3_MARSHALLING_LOAD_PREAD
+                        return fd_ >= 0;
+#else
+                        return stream_.is_open();
+#endif
+                    }
+
+                    /// @brief Get the size of the file in bytes, false if it's not available.
+                    bool size(std::uint64_t &result) {
+#ifdef CRYPTO3_MARSHALLING_LOAD_PREAD
+                        struct stat info;
+                        if (::fstat(fd_, &info) != 0 || !S_ISREG(info.st_mode)) {
+                            return false;
+                        }
+                        result = static_cast<std::uint64_t>(info.st_size);
+                        return true;
+#else
+                        stream_.seekg(0, std::ios::end);
+                        std::streamoff end = stream_.tellg();
+                        if (!stream_ || end < 0) {
+                            return false;
+                        }
+                        result = static_cast<std::uint64_t>(end);
+                        return true;
+#endif
+                    }
+
+                    /// @brief Read exactly count bytes at offset, false on an error or a short file.
+                    bool read(std::uint8_t *buffer, std::size_t count, std::uint64_t offset) {
+#ifdef CRYPTO3_MARSHALLING_LOAD_PREAD
+                        while (count > 0) {
+                            ::ssize_t done = ::pread(fd_, buffer, count, static_cast<::off_t>(offset));
+                            if (done < 0 && errno == EINTR) {
+                                continue;
+                            }
+                            if (done <= 0) {
+                                return false;
+                            }
+                            buffer += done;
+                            count -= static_cast<std::size_t>(done);
+                            offset += static_cast<std::uint64_t>(done);
+                        }
+                        return true;
+#else
+                        stream_.seekg(static_cast<std::streamoff>(offset));
+                        stream_.read(reinterpret_cast<char *>(buffer), static_cast<std::streamsize>(count));
+                        return static_cast<bool>(stream_);
+#endif
+                    }
+
+                private:
+#ifdef CRYPTO3_MARSHALLING_LOAD_PREAD
+                    int fd_ = -1;
+#else
+                    std::ifstream stream_;
+#endif
+                };
+            }    // namespace detail
+
+            /// @brief Load a file of fixed precision values written back to back, as by pack().
+            /// @details The file is read in blocks of block_size bytes (rounded down to whole
+            ///     values) into a ring of ring_size buffers. The calling thread issues the reads
+            ///     while worker threads decode the blocks already read straight into their place
+            ///     in the result, so disk reads overlap with decoding. A buffer is reused as soon
+            ///     as its block is decoded, memory used besides the result is bounded by
+            ///     ring_size * block_size.
+            /// @tparam TEndian Endianness option the values were written with.
+            /// @param[in] path Path of the file.
+            /// @param[out] values Decoded values, one per serialized_length() bytes of the file.
+            /// @param[in] block_size Number of bytes read at once.
+            /// @param[in] ring_size Number of buffers, i.e. blocks read or decoded at the same time.
+            /// @param[in] threads_count Maximal number of decoding threads, zero means all the
+            ///     hardware threads.
+            /// @return not_enough_data if the file can't be opened or read, invalid_msg_data if
+            ///     its size isn't a multiple of the value length, success otherwise. On failure
+            ///     values isn't changed.
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates>
+            nil::marshalling::status_type
+                load_file(const std::string &path,
+                          std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values,
+                          std::size_t block_size = default_load_block_size,
+                          std::size_t ring_size = default_load_ring_size, std::size_t threads_count = 0) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+
+                static_assert(boost::multiprecision::backends::is_fixed_precision<Backend>::value,
+                              "loading is defined for fixed precision values only");
+                constexpr std::size_t value_length = serialized_length<value_type>::value;
+
+                detail::load_file_reader file(path);
+                std::uint64_t file_size = 0;
+                if (!file.is_open() || !file.size(file_size)) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+                if (file_size % value_length != 0) {
+                    return nil::marshalling::status_type::invalid_msg_data;
+                }
+
+                std::size_t count = static_cast<std::size_t>(file_size / value_length);
+                std::size_t block_values = std::max<std::size_t>(block_size / value_length, 1);
+                std::size_t blocks_count = count / block_values + ((count % block_values) ? 1 : 0);
+                ring_size = std::min(std::max<std::size_t>(ring_size, 1), std::max<std::size_t>(blocks_count, 1));
+                threads_count = std::min(processing::detail::threads_count_or_default(threads_count), ring_size);
+
+                std::vector<value_type> result(count);
+                std::vector<std::vector<std::uint8_t>> ring(ring_size,
+                                                            std::vector<std::uint8_t>(block_values * value_length));
+                // Block each slot of the ring holds, slots move between the free and the read lists
+                std::vector<std::size_t> slot_blocks(ring_size);
+                std::vector<std::size_t> free_slots;
+                std::deque<std::size_t> read_slots;
+                for (std::size_t i = 0; i < ring_size; ++i) {
+                    free_slots.push_back(ring_size - 1 - i);
+                }
+                bool reading_done = false;
+                std::mutex mutex;
+                std::condition_variable slot_read;
+                std::condition_variable slot_freed;
+
+                auto decode = [&]() {
+                    for (;;) {
+                        std::size_t slot;
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            slot_read.wait(lock, [&]() { return !read_slots.empty() || reading_done; });
+                            if (read_slots.empty()) {
+                                return;
+                            }
+                            slot = read_slots.front();
+                            read_slots.pop_front();
+                        }
+
+                        std::size_t first = slot_blocks[slot] * block_values;
+                        std::size_t last = std::min(count, first + block_values);
+                        const std::uint8_t *data = ring[slot].data();
+                        detail::unpack_range_from<TEndian>(data, result.data() + first, result.data() + last);
+
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            free_slots.push_back(slot);
+                        }
+                        slot_freed.notify_one();
+                    }
+                };
+
+                std::vector<std::thread> workers;
+                workers.reserve(threads_count);
+                for (std::size_t i = 0; i < threads_count; ++i) {
+                    workers.emplace_back(decode);
+                }
+
+                bool read_failed = false;
+                for (std::size_t block = 0; block < blocks_count; ++block) {
+                    std::size_t slot;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        slot_freed.wait(lock, [&]() { return !free_slots.empty(); });
+                        slot = free_slots.back();
+                        free_slots.pop_back();
+                    }
+
+                    std::size_t first = block * block_values;
+                    std::size_t length = (std::min(count, first + block_values) - first) * value_length;
+                    if (!file.read(ring[slot].data(), length, static_cast<std::uint64_t>(first) * value_length)) {
+                        read_failed = true;
+                        break;
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        slot_blocks[slot] = block;
+                        read_slots.push_back(slot);
+                    }
+                    slot_read.notify_one();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    reading_done = true;
+                }
+                slot_read.notify_all();
+                for (std::thread &worker : workers) {
+                    worker.join();
+                }
+
+                if (read_failed) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+                values = std::move(result);
+                return nil::marshalling::status_type::success;
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_LOAD_HPP
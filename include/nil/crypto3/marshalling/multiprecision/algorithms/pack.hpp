@@ -0,0 +1,181 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_PACK_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_PACK_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/field_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/kernel_registry.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Number of bytes the fixed precision value (or fixed size array of them)
+            ///     is serialized into.
+            template<typename T>
+            struct serialized_length;
+
+            template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+            struct serialized_length<boost::multiprecision::number<Backend, ExpressionTemplates>>
+                : std::integral_constant<
+                      std::size_t,
+                      types::detail::basic_integral<nil::marshalling::field_type<nil::marshalling::option::big_endian>,
+                                                    Backend, ExpressionTemplates>::max_length()> {
+                static_assert(boost::multiprecision::backends::is_fixed_precision<Backend>::value,
+                              "serialized length is known at compile time for fixed precision values only");
+            };
+
+            template<typename T, std::size_t TSize>
+            struct serialized_length<std::array<T, TSize>>
+                : std::integral_constant<std::size_t, serialized_length<T>::value * TSize> { };
+
+            template<typename T>
+            constexpr std::size_t serialized_length_v = serialized_length<T>::value;
+
+            namespace detail {
+                template<typename TEndian, typename Backend,
+                         boost::multiprecision::expression_template_option ExpressionTemplates, typename TIter>
+                void pack_into(const boost::multiprecision::number<Backend, ExpressionTemplates> &value, TIter &iter) {
+                    using integral_type = types::integral<nil::marshalling::field_type<TEndian>,
+                                                          boost::multiprecision::number<Backend, ExpressionTemplates>>;
+
+                    integral_type(value).write_no_status(iter);
+                    iter += integral_type::max_length();
+                }
+
+                template<typename TEndian, typename T, std::size_t TSize, typename TIter>
+                void pack_into(const std::array<T, TSize> &values, TIter &iter) {
+                    for (const T &value : values) {
+                        pack_into<TEndian>(value, iter);
+                    }
+                }
+
+                /// @brief Serialize the contiguous run of fixed precision values back to back.
+                /// @details Byte contiguous output is written by a single call of the kernel bound
+                ///     in processing::write_kernel_registry, see processing::is_kernel_dispatched,
+                ///     other outputs value by value as by pack_into().
+                template<typename TEndian, typename T, typename TIter>
+                void pack_range_into(const T *first, const T *last, TIter &iter) {
+                    using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+
+                    if constexpr (processing::is_kernel_dispatched<T, TIter>::value) {
+                        static_assert(processing::detail::kernel_value_length<T>::value == serialized_length<T>::value,
+                                      "kernels must produce the integral encoding");
+
+                        if (first != last) {
+                            std::uint8_t *out = reinterpret_cast<std::uint8_t *>(&*iter);
+                            processing::write_kernel_registry<T, endian_type>::instance().write(first, last, out);
+                            iter += (last - first) * serialized_length<T>::value;
+                        }
+                    } else {
+                        for (; first != last; ++first) {
+                            pack_into<TEndian>(*first, iter);
+                        }
+                    }
+                }
+
+                /// @brief Deserialize the contiguous run of fixed precision values written by
+                ///     pack_range_into().
+                /// @details Byte contiguous input is read by a single call of the kernel bound in
+                ///     processing::read_kernel_registry, other inputs value by value.
+                /// @pre The input holds (last - first) * serialized_length<T>::value bytes.
+                template<typename TEndian, typename T, typename TIter>
+                void unpack_range_from(TIter &iter, T *first, T *last) {
+                    using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+
+                    if constexpr (processing::is_kernel_dispatched<T, TIter>::value) {
+                        static_assert(processing::detail::kernel_value_length<T>::value == serialized_length<T>::value,
+                                      "kernels must read the integral encoding");
+
+                        if (first != last) {
+                            const std::uint8_t *in = reinterpret_cast<const std::uint8_t *>(&*iter);
+                            processing::read_kernel_registry<T, endian_type>::instance().read(in, first, last);
+                            iter += (last - first) * serialized_length<T>::value;
+                        }
+                    } else {
+                        for (; first != last; ++first) {
+                            types::integral<nil::marshalling::field_type<TEndian>, T> field;
+                            field.read(iter, serialized_length<T>::value);
+                            *first = field.value();
+                        }
+                    }
+                }
+            }    // namespace detail
+
+            /// @brief Serialize fixed precision value (or fixed size array of them) into the
+            ///     caller provided buffer.
+            /// @details Buffer size is checked at compile time, no allocation is performed.
+            /// @tparam TEndian Endianness option, e.g. nil::marshalling::option::big_endian.
+            /// @param[in] value Value to serialize.
+            /// @param[out] buffer Output buffer of exactly serialized_length<T>::value bytes.
+            template<typename TEndian, typename T, std::size_t N>
+            void pack(const T &value, std::array<std::uint8_t, N> &buffer) {
+                static_assert(N == serialized_length<T>::value, "buffer size doesn't match serialized length");
+
+                auto iter = buffer.begin();
+                detail::pack_into<TEndian>(value, iter);
+            }
+
+#if defined(__cpp_lib_span)
+            /// @brief Serialize fixed precision value (or fixed size array of them) into the
+            ///     caller provided static extent span.
+            template<typename TEndian, typename T, std::size_t N>
+            void pack(const T &value, std::span<std::uint8_t, N> buffer) {
+                static_assert(N == serialized_length<T>::value, "buffer size doesn't match serialized length");
+
+                auto iter = buffer.begin();
+                detail::pack_into<TEndian>(value, iter);
+            }
+#endif
+
+            /// @brief Serialize fixed precision value (or fixed size array of them) into the
+            ///     std::array of size known at compile time.
+            /// @tparam TEndian Endianness option, e.g. nil::marshalling::option::big_endian.
+            /// @param[in] value Value to serialize.
+            /// @return Serialized value.
+            template<typename TEndian, typename T>
+            std::array<std::uint8_t, serialized_length<T>::value> pack(const T &value) {
+                std::array<std::uint8_t, serialized_length<T>::value> result;
+                pack<TEndian>(value, result);
+                return result;
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_PACK_HPP
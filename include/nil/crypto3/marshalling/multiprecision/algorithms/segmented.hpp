@@ -0,0 +1,210 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_SEGMENTED_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_SEGMENTED_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Input over a chain of byte segments, e.g. ring buffer slices or received
+            ///     packets.
+            /// @details Segments are anything with data() and size() members describing a byte
+            ///     range (std::vector<std::uint8_t>, std::string_view, asio buffers and so on). The
+            ///     segments are not copied and must outlive the input.
+            template<typename TSegmentIter>
+            class segmented_input {
+            public:
+                segmented_input(TSegmentIter first, TSegmentIter last) : segment_(first), last_(last) {
+                    for (TSegmentIter iter = first; iter != last; ++iter) {
+                        remaining_ += iter->size();
+                    }
+                    skip_empty();
+                }
+
+                /// @brief Total number of bytes left in all the segments.
+                std::size_t remaining() const {
+                    return remaining_;
+                }
+
+                /// @brief Pointer to the next size bytes if they lie in the current segment,
+                ///     nullptr otherwise.
+                const std::uint8_t *contiguous(std::size_t size) const {
+                    if (segment_ == last_ || segment_->size() - offset_ < size) {
+                        return nullptr;
+                    }
+                    return segment_data() + offset_;
+                }
+
+                /// @brief Copy the next size bytes into the output and advance past them.
+                /// @pre remaining() >= size
+                void copy(std::uint8_t *out, std::size_t size) {
+                    while (size) {
+                        std::size_t chunk = std::min(size, segment_->size() - offset_);
+                        out = std::copy_n(segment_data() + offset_, chunk, out);
+                        advance(chunk);
+                        size -= chunk;
+                    }
+                }
+
+                /// @brief Advance past the next size bytes.
+                /// @pre remaining() >= size
+                void advance(std::size_t size) {
+                    remaining_ -= size;
+                    while (size) {
+                        std::size_t chunk = std::min(size, segment_->size() - offset_);
+                        offset_ += chunk;
+                        size -= chunk;
+                        skip_empty();
+                    }
+                }
+
+            private:
+                const std::uint8_t *segment_data() const {
+                    return static_cast<const std::uint8_t *>(static_cast<const void *>(segment_->data()));
+                }
+
+                void skip_empty() {
+                    while (segment_ != last_ && offset_ == segment_->size()) {
+                        ++segment_;
+                        offset_ = 0;
+                    }
+                }
+
+                TSegmentIter segment_;
+                TSegmentIter last_;
+                std::size_t offset_ = 0;
+                std::size_t remaining_ = 0;
+            };
+
+            namespace detail {
+                template<typename TEndian, typename T, typename TSegmentIter, typename TStitchBuffer>
+                nil::marshalling::status_type read_segmented(segmented_input<TSegmentIter> &input, std::size_t size,
+                                                             T &value, TStitchBuffer &stitch) {
+                    using integral_type = types::integral<nil::marshalling::field_type<TEndian>, T>;
+
+                    if (input.remaining() < size) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+
+                    integral_type field;
+                    nil::marshalling::status_type status;
+                    if (const std::uint8_t *data = input.contiguous(size)) {
+                        status = field.read(data, size);
+                        input.advance(size);
+                    } else {
+                        // The value straddles the segments boundary, only its bytes are gathered
+                        input.copy(stitch.data(), size);
+                        const std::uint8_t *stitch_data = stitch.data();
+                        status = field.read(stitch_data, size);
+                    }
+
+                    if (status == nil::marshalling::status_type::success) {
+                        value = field.value();
+                    }
+                    return status;
+                }
+            }    // namespace detail
+
+            /// @brief Read fixed precision value from the segmented input.
+            /// @details The value is read in place if it lies within a single segment, otherwise
+            ///     its serialized_length<T> bytes are gathered into a stack stitch buffer first.
+            /// @tparam TEndian Endianness option, e.g. nil::marshalling::option::big_endian.
+            /// @return not_enough_data if the input is too short, the input is not advanced then.
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates, typename TSegmentIter>
+            nil::marshalling::status_type
+                read_segmented(segmented_input<TSegmentIter> &input,
+                               boost::multiprecision::number<Backend, ExpressionTemplates> &value) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+
+                std::array<std::uint8_t, serialized_length<value_type>::value> stitch;
+                return detail::read_segmented<TEndian>(input, stitch.size(), value, stitch);
+            }
+
+            /// @brief Read size bytes long non fixed precision value from the segmented input.
+            /// @details The value is read in place if it lies within a single segment, otherwise
+            ///     its bytes are gathered into a stitch buffer of the value size first.
+            /// @return not_enough_data if the input is too short, the input is not advanced then.
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates, typename TSegmentIter>
+            nil::marshalling::status_type
+                read_segmented(segmented_input<TSegmentIter> &input, std::size_t size,
+                               boost::multiprecision::number<Backend, ExpressionTemplates> &value) {
+                static_assert(!boost::multiprecision::backends::is_fixed_precision<Backend>::value,
+                              "fixed precision values have the size defined by the type");
+
+                std::vector<std::uint8_t> stitch;
+                if (!input.contiguous(size)) {
+                    stitch.resize(size);
+                }
+                return detail::read_segmented<TEndian>(input, size, value, stitch);
+            }
+
+            /// @brief Read sequence of fixed precision values from the segmented input.
+            /// @details The number of values to read is defined by the output range. Values within a
+            ///     single segment are read in place, only the ones straddling segment boundaries
+            ///     go through the stitch buffer.
+            /// @return not_enough_data if the input is too short, the input is not advanced then.
+            template<typename TEndian, typename TSegmentIter, typename TOutputIter>
+            nil::marshalling::status_type read_segmented(segmented_input<TSegmentIter> &input, TOutputIter first,
+                                                         TOutputIter last) {
+                using value_type = typename std::iterator_traits<TOutputIter>::value_type;
+
+                std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+                if (input.remaining() < count * serialized_length<value_type>::value) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+
+                std::array<std::uint8_t, serialized_length<value_type>::value> stitch;
+                for (; first != last; ++first) {
+                    nil::marshalling::status_type status =
+                        detail::read_segmented<TEndian>(input, stitch.size(), *first, stitch);
+                    if (status != nil::marshalling::status_type::success) {
+                        return status;
+                    }
+                }
+                return nil::marshalling::status_type::success;
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_SEGMENTED_HPP
@@ -0,0 +1,395 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_SERVICE_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_SERVICE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/mpmc_queue.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/parallel.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Outcome of a decoding job of serialization_service.
+            template<typename T>
+            struct decode_result {
+                nil::marshalling::status_type status;
+                std::vector<T> values;
+            };
+
+            namespace detail {
+                template<typename T, typename TCallback>
+                struct encode_job {
+                    std::vector<T> values;
+                    std::vector<std::uint8_t> buffer;
+                    TCallback callback;
+                };
+
+                template<typename T, typename TCallback>
+                struct decode_job {
+                    std::vector<std::uint8_t> buffer;
+                    std::vector<T> values;
+                    TCallback callback;
+                };
+            }    // namespace detail
+
+            /// @brief Pool of threads encoding and decoding vectors of fixed precision values.
+            /// @details Jobs are submitted through a lock-free queue shared by all the workers, so
+            ///     any number of producer threads may submit concurrently. A job over more than
+            ///     grain_size values is split into sub-tasks pushed to the deque of the worker
+            ///     running it. The worker takes them back from the newest end while idle workers
+            ///     steal them from the oldest one, so a huge vector is spread over the pool instead
+            ///     of holding up the small jobs queued behind it. Each deque has its own mutex,
+            ///     which only contends when a steal happens.
+            ///
+            ///     Vectors are encoded as by serialization_context: a std::size_t size prefix
+            ///     followed by the values. Completion is reported through a callback invoked on a
+            ///     worker thread, which must not throw, or through a future.
+            ///
+            ///     The destructor runs every job already submitted before joining the workers, it
+            ///     must not race with submissions.
+            class serialization_service {
+            public:
+                using task_type = std::function<void()>;
+
+                static constexpr std::size_t default_grain_size = 4096;
+                static constexpr std::size_t default_queue_capacity = 1024;
+
+                /// @param[in] threads_count Number of worker threads, zero means all the hardware
+                ///     threads.
+                /// @param[in] grain_size Number of values a single sub-task processes.
+                /// @param[in] queue_capacity Number of submitted jobs the queue holds, producers
+                ///     other than the workers wait for a free slot once it's full.
+                explicit serialization_service(std::size_t threads_count = 0,
+                                               std::size_t grain_size = default_grain_size,
+                                               std::size_t queue_capacity = default_queue_capacity) :
+                    queue_(queue_capacity),
+                    grain_size_(std::max<std::size_t>(grain_size, 1)) {
+                    threads_count = processing::detail::threads_count_or_default(threads_count);
+                    for (std::size_t i = 0; i < threads_count; ++i) {
+                        deques_.emplace_back(new worker_deque());
+                    }
+                    threads_.reserve(threads_count);
+                    for (std::size_t i = 0; i < threads_count; ++i) {
+                        threads_.emplace_back([this, i]() { run(i); });
+                    }
+                }
+
+                serialization_service(const serialization_service &) = delete;
+                serialization_service &operator=(const serialization_service &) = delete;
+
+                ~serialization_service() {
+                    stopping_.store(true);
+                    {
+                        std::lock_guard<std::mutex> lock(sleep_mutex_);
+                    }
+                    wake_.notify_all();
+                    for (std::thread &thread : threads_) {
+                        thread.join();
+                    }
+                }
+
+                std::size_t threads_count() const {
+                    return threads_.size();
+                }
+
+                /// @brief Submit an arbitrary task.
+                /// @details From a worker of this service, e.g. from a completion callback, the task
+                ///     goes to the deque of the worker instead of the queue: waiting there for a
+                ///     free slot could block the very threads supposed to free one.
+                void submit(task_type task) {
+                    if (current_worker().service == this) {
+                        spawn(std::move(task));
+                        return;
+                    }
+                    pending_.fetch_add(1);
+                    while (!queue_.try_push(std::move(task))) {
+                        std::this_thread::yield();
+                    }
+                    notify();
+                }
+
+                /// @brief Encode the values, callback(std::vector<std::uint8_t>) gets the result.
+                template<typename TEndian, typename Backend,
+                         boost::multiprecision::expression_template_option ExpressionTemplates, typename TCallback>
+                void encode(std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> values,
+                            TCallback callback) {
+                    using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+                    using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+                    using job_type = detail::encode_job<value_type, TCallback>;
+
+                    constexpr std::size_t value_length = serialized_length<value_type>::value;
+
+                    std::shared_ptr<job_type> job(new job_type {std::move(values), {}, std::move(callback)});
+                    submit([this, job]() {
+                        std::size_t count = job->values.size();
+                        job->buffer.resize(sizeof(std::size_t) + count * value_length);
+                        auto iter = job->buffer.begin();
+                        processing::detail::write_word<endian_type>(count, iter);
+
+                        for_chunks(
+                            count,
+                            [job](std::size_t begin, std::size_t end) {
+                                auto iter = job->buffer.begin() + sizeof(std::size_t) + begin * value_length;
+                                detail::pack_range_into<TEndian>(job->values.data() + begin,
+                                                                 job->values.data() + end, iter);
+                            },
+                            [job]() { job->callback(std::move(job->buffer)); });
+                    });
+                }
+
+                /// @brief Encode the values.
+                /// @return Future of the encoded bytes.
+                template<typename TEndian, typename Backend,
+                         boost::multiprecision::expression_template_option ExpressionTemplates>
+                std::future<std::vector<std::uint8_t>>
+                    encode(std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> values) {
+                    auto promise = std::make_shared<std::promise<std::vector<std::uint8_t>>>();
+                    std::future<std::vector<std::uint8_t>> result = promise->get_future();
+                    encode<TEndian>(std::move(values), [promise](std::vector<std::uint8_t> buffer) {
+                        promise->set_value(std::move(buffer));
+                    });
+                    return result;
+                }
+
+                /// @brief Decode values written by encode(), callback(status_type, std::vector<T>)
+                ///     gets the result.
+                /// @details The status is not_enough_data and the vector is empty if the buffer is
+                ///     shorter than its size prefix tells. Bytes past the values are ignored.
+                template<typename TEndian, typename T, typename TCallback>
+                void decode(std::vector<std::uint8_t> buffer, TCallback callback) {
+                    using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+                    using job_type = detail::decode_job<T, TCallback>;
+
+                    constexpr std::size_t value_length = serialized_length<T>::value;
+
+                    std::shared_ptr<job_type> job(new job_type {std::move(buffer), {}, std::move(callback)});
+                    submit([this, job]() {
+                        std::size_t size = job->buffer.size();
+                        if (size < sizeof(std::size_t)) {
+                            job->callback(nil::marshalling::status_type::not_enough_data, std::vector<T>());
+                            return;
+                        }
+                        auto iter = job->buffer.cbegin();
+                        std::size_t count = processing::detail::read_word<endian_type, std::size_t>(iter);
+                        if (count > (size - sizeof(std::size_t)) / value_length) {
+                            job->callback(nil::marshalling::status_type::not_enough_data, std::vector<T>());
+                            return;
+                        }
+                        job->values.resize(count);
+
+                        for_chunks(
+                            count,
+                            [job](std::size_t begin, std::size_t end) {
+                                auto iter = job->buffer.cbegin() + sizeof(std::size_t) + begin * value_length;
+                                detail::unpack_range_from<TEndian>(iter, job->values.data() + begin,
+                                                                   job->values.data() + end);
+                            },
+                            [job]() {
+                                job->callback(nil::marshalling::status_type::success, std::move(job->values));
+                            });
+                    });
+                }
+
+                /// @brief Decode values written by encode().
+                /// @return Future of the status and the values.
+                template<typename TEndian, typename T>
+                std::future<decode_result<T>> decode(std::vector<std::uint8_t> buffer) {
+                    auto promise = std::make_shared<std::promise<decode_result<T>>>();
+                    std::future<decode_result<T>> result = promise->get_future();
+                    decode<TEndian, T>(std::move(buffer),
+                                       [promise](nil::marshalling::status_type status, std::vector<T> values) {
+                                           promise->set_value(decode_result<T> {status, std::move(values)});
+                                       });
+                    return result;
+                }
+
+            private:
+                struct worker_deque {
+                    std::mutex mutex;
+                    std::deque<task_type> tasks;
+                };
+
+                struct worker_identity {
+                    const serialization_service *service;
+                    std::size_t index;
+                };
+
+                static worker_identity &current_worker() {
+                    static thread_local worker_identity identity {nullptr, 0};
+                    return identity;
+                }
+
+                void notify() {
+                    if (sleeping_.load() > 0) {
+                        {
+                            std::lock_guard<std::mutex> lock(sleep_mutex_);
+                        }
+                        wake_.notify_one();
+                    }
+                }
+
+                /// @brief Push the task to the deque of the current worker.
+                /// @pre Called from a worker of this service.
+                void spawn(task_type task) {
+                    pending_.fetch_add(1);
+                    {
+                        worker_deque &deque = *deques_[current_worker().index];
+                        std::lock_guard<std::mutex> lock(deque.mutex);
+                        deque.tasks.push_back(std::move(task));
+                    }
+                    notify();
+                }
+
+                /// @brief Run process(begin, end) over [0, count) in chunks of grain_size values
+                ///     and then done() once.
+                /// @details The first chunk runs on the calling thread, the rest are spawned for
+                ///     stealing. Whichever chunk finishes last runs done().
+                template<typename TProcess, typename TDone>
+                void for_chunks(std::size_t count, TProcess process, TDone done) {
+                    std::size_t chunks_count = count / grain_size_ + ((count % grain_size_) ? 1 : 0);
+                    if (chunks_count <= 1) {
+                        if (count > 0) {
+                            process(std::size_t(0), count);
+                        }
+                        done();
+                        return;
+                    }
+
+                    struct state_type {
+                        std::atomic<std::size_t> remaining;
+                        TProcess process;
+                        TDone done;
+                    };
+                    std::shared_ptr<state_type> state(
+                        new state_type {{chunks_count}, std::move(process), std::move(done)});
+                    std::size_t grain_size = grain_size_;
+                    auto run_chunk = [state, grain_size, count](std::size_t chunk) {
+                        std::size_t begin = chunk * grain_size;
+                        state->process(begin, std::min(count, begin + grain_size));
+                        if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                            state->done();
+                        }
+                    };
+
+                    // Pushed from the last, so the owner takes them back in order and thieves get
+                    // the farthest ones
+                    for (std::size_t chunk = chunks_count - 1; chunk > 0; --chunk) {
+                        spawn([run_chunk, chunk]() { run_chunk(chunk); });
+                    }
+                    run_chunk(0);
+                }
+
+                bool take(std::size_t index, task_type &task) {
+                    {
+                        worker_deque &deque = *deques_[index];
+                        std::lock_guard<std::mutex> lock(deque.mutex);
+                        if (!deque.tasks.empty()) {
+                            task = std::move(deque.tasks.back());
+                            deque.tasks.pop_back();
+                            return true;
+                        }
+                    }
+                    if (queue_.try_pop(task)) {
+                        return true;
+                    }
+                    for (std::size_t i = 1; i < deques_.size(); ++i) {
+                        worker_deque &deque = *deques_[(index + i) % deques_.size()];
+                        std::lock_guard<std::mutex> lock(deque.mutex);
+                        if (!deque.tasks.empty()) {
+                            task = std::move(deque.tasks.front());
+                            deque.tasks.pop_front();
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                void run(std::size_t index) {
+                    current_worker() = worker_identity {this, index};
+
+                    task_type task;
+                    for (;;) {
+                        if (take(index, task)) {
+                            pending_.fetch_sub(1);
+                            task();
+                            task = nullptr;
+                            continue;
+                        }
+                        // Counted before being pushed, it's about to become visible
+                        if (pending_.load() > 0) {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        if (stopping_.load()) {
+                            return;
+                        }
+
+                        std::unique_lock<std::mutex> lock(sleep_mutex_);
+                        sleeping_.fetch_add(1);
+                        wake_.wait(lock, [this]() { return pending_.load() > 0 || stopping_.load(); });
+                        sleeping_.fetch_sub(1);
+                    }
+                }
+
+                processing::detail::mpmc_queue<task_type> queue_;
+                std::vector<std::unique_ptr<worker_deque>> deques_;
+                std::vector<std::thread> threads_;
+                std::size_t grain_size_;
+
+                // Tasks submitted or spawned and not taken yet
+                std::atomic<std::size_t> pending_ {0};
+                std::atomic<std::size_t> sleeping_ {0};
+                std::atomic<bool> stopping_ {false};
+                std::mutex sleep_mutex_;
+                std::condition_variable wake_;
+            };
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_SERVICE_HPP
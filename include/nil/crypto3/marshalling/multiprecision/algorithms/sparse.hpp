@@ -0,0 +1,307 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_SPARSE_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_SPARSE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Word the values count of the sparse container encoding is stored in.
+            using sparse_count_type = std::uint64_t;
+
+            /// @brief Form the values of the sparse container encoding are stored in.
+            enum class sparse_mode : std::uint8_t {
+                /// Every value is written, as by the fixed precision integral.
+                dense = 0,
+                /// Bitmap of the non-zero values followed by these values only.
+                bitmap = 1
+            };
+
+            namespace detail {
+                constexpr std::size_t sparse_header_length() {
+                    return sizeof(sparse_mode) + sizeof(sparse_count_type);
+                }
+
+                constexpr std::size_t sparse_bitmap_length(std::size_t count) {
+                    return count / 8 + ((count % 8) ? 1 : 0);
+                }
+
+                template<typename T>
+                std::size_t sparse_length(sparse_mode mode, std::size_t count, std::size_t non_zero_count) {
+                    if (mode == sparse_mode::dense) {
+                        return sparse_header_length() + count * serialized_length<T>::value;
+                    }
+                    return sparse_header_length() + sparse_bitmap_length(count) +
+                           non_zero_count * serialized_length<T>::value;
+                }
+
+                template<typename T>
+                std::size_t non_zero_count(const std::vector<T> &values) {
+                    std::size_t result = 0;
+                    for (const T &value : values) {
+                        result += value.is_zero() ? 0 : 1;
+                    }
+                    return result;
+                }
+
+                template<typename T>
+                sparse_mode select_sparse_mode(std::size_t count, std::size_t non_zero_count) {
+                    return sparse_length<T>(sparse_mode::bitmap, count, non_zero_count) <
+                                   sparse_length<T>(sparse_mode::dense, count, non_zero_count) ?
+                               sparse_mode::bitmap :
+                               sparse_mode::dense;
+                }
+            }    // namespace detail
+
+            /// @brief Number of bytes the values take in the sparse container encoding.
+            /// @details The smaller of the dense and bitmap forms is taken, see write_sparse().
+            template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+            std::size_t
+                sparse_length(const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+
+                std::size_t non_zero_count = detail::non_zero_count(values);
+                return detail::sparse_length<value_type>(
+                    detail::select_sparse_mode<value_type>(values.size(), non_zero_count), values.size(),
+                    non_zero_count);
+            }
+
+            /// @brief Write the values in the sparse container encoding.
+            /// @details The layout is the sparse_mode byte, the values count as a 64 bit word in
+            ///     the values endianness and the values. In the dense form every value is written
+            ///     as by the fixed precision integral. In the bitmap form a bitmap of the non-zero
+            ///     values (bit i % 8 of byte i / 8 set for a non-zero value i) is followed by the
+            ///     non-zero values only. The bitmap form is taken whenever it is shorter, i.e.
+            ///     roughly when less than 1 - 1 / (8 * serialized_length<T>) of the values are
+            ///     non-zero, so mostly zero vectors shrink close to their non-zero payload.
+            /// @tparam TEndian Endianness option, e.g. nil::marshalling::option::big_endian.
+            /// @param[in] values Values to write.
+            /// @param[in, out] iter Random access output iterator.
+            /// @param[in] size Number of bytes available for writing.
+            /// @return buffer_overflow if the encoding doesn't fit, nothing is written then,
+            ///     success otherwise.
+            /// @post The iterator is advanced past the encoding.
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates, typename TIter>
+            nil::marshalling::status_type
+                write_sparse(const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values,
+                             TIter &iter, std::size_t size) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+                using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+                using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                static_assert(boost::multiprecision::backends::is_fixed_precision<Backend>::value,
+                              "sparse encoding is defined for fixed precision values only");
+
+                std::size_t non_zero_count = detail::non_zero_count(values);
+                sparse_mode mode = detail::select_sparse_mode<value_type>(values.size(), non_zero_count);
+                if (size < detail::sparse_length<value_type>(mode, values.size(), non_zero_count)) {
+                    return nil::marshalling::status_type::buffer_overflow;
+                }
+
+                *iter = static_cast<unit_type>(mode);
+                ++iter;
+                processing::detail::write_word<endian_type>(static_cast<sparse_count_type>(values.size()), iter);
+
+                if (mode == sparse_mode::dense) {
+                    for (const value_type &value : values) {
+                        detail::pack_into<TEndian>(value, iter);
+                    }
+                    return nil::marshalling::status_type::success;
+                }
+
+                for (std::size_t i = 0; i < values.size(); i += 8) {
+                    std::uint8_t bits = 0;
+                    for (std::size_t j = i; j < values.size() && j < i + 8; ++j) {
+                        bits |= static_cast<std::uint8_t>(values[j].is_zero() ? 0 : 1) << (j - i);
+                    }
+                    *iter = static_cast<unit_type>(bits);
+                    ++iter;
+                }
+                for (const value_type &value : values) {
+                    if (!value.is_zero()) {
+                        detail::pack_into<TEndian>(value, iter);
+                    }
+                }
+                return nil::marshalling::status_type::success;
+            }
+
+            /// @brief Encode the values in the sparse container encoding into a new buffer.
+            /// @see write_sparse()
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates>
+            std::vector<std::uint8_t>
+                encode_sparse(const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values) {
+                std::vector<std::uint8_t> result(sparse_length(values));
+                auto iter = result.begin();
+                write_sparse<TEndian>(values, iter, result.size());
+                return result;
+            }
+
+            /// @brief Read values written by write_sparse() into the zero-initialized range.
+            /// @details In the bitmap form only the non-zero values are decoded, the zero ones are
+            ///     skipped without touching the output. The whole encoding is validated before
+            ///     anything is written.
+            /// @tparam TEndian Endianness option the values were written with.
+            /// @param[in, out] iter Random access input iterator.
+            /// @param[in] size Number of bytes available for reading.
+            /// @param[in] first Beginning of the output range.
+            /// @param[in] last End of the output range.
+            /// @return not_enough_data if the buffer is shorter than the encoding, invalid_msg_data
+            ///     if the stored count differs from the output range size or the encoding is
+            ///     malformed, success otherwise. On failure the iterator is not advanced.
+            /// @pre All the values of the output range are zero.
+            /// @post The iterator is advanced past the encoding.
+            template<typename TEndian, typename TIter, typename TOutputIter>
+            nil::marshalling::status_type read_sparse(TIter &iter, std::size_t size, TOutputIter first,
+                                                      TOutputIter last) {
+                using value_type = typename std::iterator_traits<TOutputIter>::value_type;
+                using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+                using integral_type = types::integral<nil::marshalling::field_type<TEndian>, value_type>;
+
+                constexpr std::size_t value_length = serialized_length<value_type>::value;
+
+                if (size < detail::sparse_header_length()) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+                TIter data = iter;
+                std::uint8_t mode = static_cast<std::uint8_t>(*data);
+                ++data;
+                sparse_count_type count = processing::detail::read_word<endian_type, sparse_count_type>(data);
+                size -= detail::sparse_header_length();
+
+                if (count != static_cast<sparse_count_type>(std::distance(first, last))) {
+                    return nil::marshalling::status_type::invalid_msg_data;
+                }
+
+                if (mode == static_cast<std::uint8_t>(sparse_mode::dense)) {
+                    if (count > size / value_length) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+                    for (; first != last; ++first) {
+                        integral_type field;
+                        field.read(data, value_length);
+                        *first = field.value();
+                    }
+                    iter = data;
+                    return nil::marshalling::status_type::success;
+                }
+
+                if (mode != static_cast<std::uint8_t>(sparse_mode::bitmap)) {
+                    return nil::marshalling::status_type::invalid_msg_data;
+                }
+
+                std::size_t bitmap_length = detail::sparse_bitmap_length(static_cast<std::size_t>(count));
+                if (size < bitmap_length) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+                TIter bitmap = data;
+                std::size_t non_zero_count = 0;
+                for (std::size_t i = 0; i < bitmap_length; ++i, ++data) {
+                    std::uint8_t bits = static_cast<std::uint8_t>(*data);
+                    for (; bits; bits &= static_cast<std::uint8_t>(bits - 1)) {
+                        ++non_zero_count;
+                    }
+                }
+                if (count % 8 && (static_cast<std::uint8_t>(*(data - 1)) >> (count % 8))) {
+                    return nil::marshalling::status_type::invalid_msg_data;
+                }
+                if (non_zero_count > (size - bitmap_length) / value_length) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+
+                std::size_t remaining = static_cast<std::size_t>(count);
+                for (std::size_t i = 0; i < bitmap_length; ++i, ++bitmap) {
+                    std::uint8_t bits = static_cast<std::uint8_t>(*bitmap);
+                    std::size_t block_size = std::min<std::size_t>(8, remaining);
+                    remaining -= block_size;
+                    if (!bits) {
+                        std::advance(first, block_size);
+                        continue;
+                    }
+                    for (std::size_t j = 0; j < block_size; ++j, ++first) {
+                        if (bits & (1u << j)) {
+                            integral_type field;
+                            field.read(data, value_length);
+                            *first = field.value();
+                        }
+                    }
+                }
+
+                iter = data;
+                return nil::marshalling::status_type::success;
+            }
+
+            /// @brief Read values written by write_sparse() into the vector.
+            /// @details The vector is resized to the stored count and zero-filled first.
+            /// @see read_sparse()
+            template<typename TEndian, typename Backend,
+                     boost::multiprecision::expression_template_option ExpressionTemplates, typename TIter>
+            nil::marshalling::status_type
+                read_sparse(TIter &iter, std::size_t size,
+                            std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values) {
+                using value_type = boost::multiprecision::number<Backend, ExpressionTemplates>;
+                using endian_type = typename nil::marshalling::field_type<TEndian>::endian_type;
+
+                if (size < detail::sparse_header_length()) {
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+                TIter data = iter;
+                ++data;
+                sparse_count_type count = processing::detail::read_word<endian_type, sparse_count_type>(data);
+                if (count / 8 > size) {
+                    // Every value takes at least a bit of the bitmap
+                    return nil::marshalling::status_type::not_enough_data;
+                }
+
+                std::vector<value_type> result(static_cast<std::size_t>(count), value_type(0));
+                nil::marshalling::status_type status = read_sparse<TEndian>(iter, size, result.begin(), result.end());
+                if (status == nil::marshalling::status_type::success) {
+                    values = std::move(result);
+                }
+                return status;
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_SPARSE_HPP
@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_ALGORITHMS_UPDATE_HPP
+#define CRYPTO3_MARSHALLING_ALGORITHMS_UPDATE_HPP
+
+#include <cstddef>
+#include <iterator>
+
+#include <nil/marshalling/status_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+
+            /// @brief Offset in bytes of the element with the given index inside the serialized
+            ///     sequence of fixed precision values.
+            template<typename T>
+            constexpr std::size_t element_offset(std::size_t index) {
+                return index * serialized_length<T>::value;
+            }
+
+            /// @brief Number of whole elements fitting into size bytes.
+            /// @details Indices must be checked against it before computing their offsets, the
+            ///     offsets of out of range indices may wrap around.
+            template<typename T>
+            constexpr std::size_t elements_count(std::size_t size) {
+                return size / serialized_length<T>::value;
+            }
+
+            /// @brief Re-encode single element of the serialized sequence of fixed precision values
+            ///     in place.
+            /// @details Uses the same kernel as integral write_no_status(), the rest of the buffer
+            ///     is not touched. The buffer may be any writable random access byte range, e.g.
+            ///     memory mapped file.
+            /// @tparam TEndian Endianness option the sequence was serialized with.
+            /// @param[in] buffer Iterator to the first element of the sequence (past any size prefix).
+            /// @param[in] size Number of bytes available in the buffer.
+            /// @param[in] index Index of the element to update.
+            /// @param[in] value New element value.
+            /// @return invalid_msg_data if the element lies outside of the buffer, success otherwise.
+            template<typename TEndian, typename TIter, typename T>
+            nil::marshalling::status_type update_element(TIter buffer, std::size_t size, std::size_t index,
+                                                         const T &value) {
+                if (index >= elements_count<T>(size)) {
+                    return nil::marshalling::status_type::invalid_msg_data;
+                }
+
+                TIter iter = buffer + static_cast<std::ptrdiff_t>(element_offset<T>(index));
+                detail::pack_into<TEndian>(value, iter);
+                return nil::marshalling::status_type::success;
+            }
+
+            /// @brief Re-encode several elements of the serialized sequence of fixed precision
+            ///     values in place.
+            /// @details All the indices are checked before anything is written, so the buffer is
+            ///     either fully patched or left untouched.
+            /// @param[in] buffer Iterator to the first element of the sequence (past any size prefix).
+            /// @param[in] size Number of bytes available in the buffer.
+            /// @param[in] first_index Beginning of the element indices range.
+            /// @param[in] last_index End of the element indices range.
+            /// @param[in] first_value Beginning of the new element values, one per index.
+            /// @return invalid_msg_data if any of the elements lies outside of the buffer, success
+            ///     otherwise.
+            template<typename TEndian, typename TIter, typename TIndexIter, typename TValueIter>
+            nil::marshalling::status_type update_elements(TIter buffer, std::size_t size, TIndexIter first_index,
+                                                          TIndexIter last_index, TValueIter first_value) {
+                using value_type = typename std::iterator_traits<TValueIter>::value_type;
+
+                std::size_t count = elements_count<value_type>(size);
+                for (TIndexIter index_iter = first_index; index_iter != last_index; ++index_iter) {
+                    if (static_cast<std::size_t>(*index_iter) >= count) {
+                        return nil::marshalling::status_type::invalid_msg_data;
+                    }
+                }
+
+                for (; first_index != last_index; ++first_index, ++first_value) {
+                    TIter iter = buffer + static_cast<std::ptrdiff_t>(element_offset<value_type>(*first_index));
+                    detail::pack_into<TEndian>(*first_value, iter);
+                }
+                return nil::marshalling::status_type::success;
+            }
+        }    // namespace marshalling
+    }        // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_ALGORITHMS_UPDATE_HPP
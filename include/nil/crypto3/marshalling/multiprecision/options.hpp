@@ -0,0 +1,44 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_MULTIPRECISION_OPTIONS_HPP
+#define CRYPTO3_MARSHALLING_MULTIPRECISION_OPTIONS_HPP
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace option {
+                /// @brief Option making @ref nil::crypto3::marshalling::types::integral keep the
+                ///     encoded bytes of its value beside it.
+                /// @details The encoding is computed on the first write and dropped whenever the
+                ///     value may change (mutable value() access, read, refresh or version update).
+                ///     Writing the same value repeatedly then only copies the stored bytes, and
+                ///     the field exposes the encoding through a shared immutable buffer handle.
+                struct cached_encoding { };
+            }    // namespace option
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_MULTIPRECISION_OPTIONS_HPP
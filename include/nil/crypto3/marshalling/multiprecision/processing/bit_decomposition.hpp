@@ -0,0 +1,158 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_BIT_DECOMPOSITION_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_BIT_DECOMPOSITION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/parallel.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+
+                /// @brief Layout of the bit matrix produced by bit_decompose().
+                enum class bit_matrix_layout {
+                    /// Every value takes bit_matrix_row_words<T>() words, bit j of value i is bit
+                    /// j % 64 of word i * row_words + j / 64.
+                    row_major,
+                    /// Bit-sliced: every bit position takes bit_matrix_column_words(count) words,
+                    /// bit j of value i is bit i % 64 of word j * column_words + i / 64.
+                    column_major
+                };
+
+                /// @brief Word the bit matrix is made of.
+                using bit_matrix_word_type = std::uint64_t;
+
+                namespace detail {
+                    constexpr std::size_t bit_matrix_word_bits = std::numeric_limits<bit_matrix_word_type>::digits;
+
+                    /// @brief In-place transpose of 64x64 bit matrix: bit j of a[i] becomes bit i of a[j].
+                    inline void transpose_bit_matrix(bit_matrix_word_type *a) {
+                        bit_matrix_word_type mask = 0x00000000FFFFFFFFULL;
+                        for (std::size_t j = 32; j != 0; j >>= 1, mask ^= (mask << j)) {
+                            for (std::size_t k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+                                bit_matrix_word_type t = ((a[k] >> j) ^ a[k | j]) & mask;
+                                a[k] ^= t << j;
+                                a[k | j] ^= t;
+                            }
+                        }
+                    }
+                }    // namespace detail
+
+                /// @brief Number of words a single value of type T takes in the row-major bit matrix.
+                template<typename T>
+                constexpr std::size_t bit_matrix_row_words() {
+                    static_assert(detail::limb_traits<T>::is_specialized, "bit decomposition requires direct limb access");
+
+                    return detail::limb_traits<T>::bits / detail::bit_matrix_word_bits +
+                           ((detail::limb_traits<T>::bits % detail::bit_matrix_word_bits) ? 1 : 0);
+                }
+
+                /// @brief Number of words a single bit position takes in the column-major bit matrix.
+                constexpr std::size_t bit_matrix_column_words(std::size_t count) {
+                    return count / detail::bit_matrix_word_bits + ((count % detail::bit_matrix_word_bits) ? 1 : 0);
+                }
+
+                /// @brief Number of words the bit matrix of count values of type T takes.
+                template<typename T>
+                constexpr std::size_t bit_matrix_words_count(std::size_t count, bit_matrix_layout layout) {
+                    return layout == bit_matrix_layout::row_major ?
+                               count * bit_matrix_row_words<T>() :
+                               detail::limb_traits<T>::bits * bit_matrix_column_words(count);
+                }
+
+                /// @brief Decompose values into little endian bits packed into words.
+                /// @details Values are split between threads, each of them writing its own part of
+                ///     the output. Column-major decomposition transposes 64x64 bit blocks, so values
+                ///     are split at 64 values boundaries.
+                /// @param[in] first Beginning of the values range, random access iterator.
+                /// @param[in] last End of the values range.
+                /// @param[out] out Output words, bit_matrix_words_count<T>(count, layout) of them.
+                /// @param[in] layout Bit matrix layout.
+                /// @param[in] threads_count Maximal number of threads to use, zero means all the
+                ///     hardware threads.
+                template<typename TInputIter>
+                void bit_decompose(TInputIter first, TInputIter last, bit_matrix_word_type *out,
+                                   bit_matrix_layout layout, std::size_t threads_count = 0) {
+                    using value_type = typename std::iterator_traits<TInputIter>::value_type;
+                    using traits = detail::limb_traits<value_type>;
+
+                    constexpr std::size_t word_bits = detail::bit_matrix_word_bits;
+                    constexpr std::size_t row_words = bit_matrix_row_words<value_type>();
+
+                    std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+
+                    if (layout == bit_matrix_layout::row_major) {
+                        detail::parallel_for(count, word_bits, threads_count, [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                const typename traits::limb_type *limbs = traits::limbs(first[i]);
+                                for (std::size_t w = 0; w < row_words; ++w) {
+                                    out[i * row_words + w] =
+                                        detail::extract_word<bit_matrix_word_type, traits::limb_count>(limbs, w);
+                                }
+                            }
+                        });
+                    } else {
+                        std::size_t column_words = bit_matrix_column_words(count);
+
+                        detail::parallel_for(count, word_bits, threads_count, [&](std::size_t begin, std::size_t end) {
+                            bit_matrix_word_type block[word_bits];
+
+                            for (std::size_t block_begin = begin; block_begin < end; block_begin += word_bits) {
+                                std::size_t block_size = std::min(word_bits, end - block_begin);
+
+                                for (std::size_t w = 0; w < row_words; ++w) {
+                                    for (std::size_t k = 0; k < word_bits; ++k) {
+                                        block[k] = k < block_size ?
+                                                       detail::extract_word<bit_matrix_word_type, traits::limb_count>(
+                                                           traits::limbs(first[block_begin + k]), w) :
+                                                       0;
+                                    }
+
+                                    detail::transpose_bit_matrix(block);
+
+                                    std::size_t bits_count = std::min(word_bits, traits::bits - w * word_bits);
+                                    for (std::size_t b = 0; b < bits_count; ++b) {
+                                        out[(w * word_bits + b) * column_words + block_begin / word_bits] = block[b];
+                                    }
+                                }
+                            }
+                        });
+                    }
+                }
+            }    // namespace processing
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_BIT_DECOMPOSITION_HPP
@@ -0,0 +1,297 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_BIT_PACKED_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_BIT_PACKED_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include <nil/marshalling/endianness.hpp>
+#include <nil/marshalling/status_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+                namespace detail {
+                    using bit_packed_word_type = std::uint64_t;
+
+                    constexpr std::size_t bit_packed_word_bits = std::numeric_limits<bit_packed_word_type>::digits;
+
+                    inline bit_packed_word_type low_bits_mask(std::size_t bits) {
+                        return bits < bit_packed_word_bits ? (bit_packed_word_type(1) << bits) - 1 :
+                                                             ~bit_packed_word_type(0);
+                    }
+
+                    /// @brief Appends words of up to 64 bits to the bit stream, least significant
+                    ///     bit first. Full 64 bits words are emitted at once.
+                    template<typename TIter>
+                    class bit_stream_writer {
+                    public:
+                        explicit bit_stream_writer(TIter &iter) : iter_(iter) {
+                        }
+
+                        /// @pre word has no bits set above bits_count.
+                        void put(bit_packed_word_type word, std::size_t bits_count) {
+                            bit_packed_word_type pending = buffer_ | (word << fill_);
+                            std::size_t total = fill_ + bits_count;
+
+                            if (total >= bit_packed_word_bits) {
+                                write_word<nil::marshalling::endian::little_endian>(pending, iter_);
+                                pending = fill_ ? word >> (bit_packed_word_bits - fill_) : 0;
+                                total -= bit_packed_word_bits;
+                            }
+                            for (; total >= 8; total -= 8, ++iter_) {
+                                *iter_ = static_cast<typename std::iterator_traits<TIter>::value_type>(pending);
+                                pending >>= 8;
+                            }
+
+                            buffer_ = pending;
+                            fill_ = total;
+                        }
+
+                        /// @brief Writes the incomplete last byte, the unused bits are zeroes.
+                        void flush() {
+                            if (fill_) {
+                                *iter_ = static_cast<typename std::iterator_traits<TIter>::value_type>(buffer_);
+                                ++iter_;
+                                buffer_ = 0;
+                                fill_ = 0;
+                            }
+                        }
+
+                    private:
+                        TIter &iter_;
+                        bit_packed_word_type buffer_ = 0;
+                        std::size_t fill_ = 0;
+                    };
+
+                    /// @brief Consumes words of up to 64 bits from the bit stream, least significant
+                    ///     bit first. Bytes are fetched only when needed.
+                    template<typename TIter>
+                    class bit_stream_reader {
+                    public:
+                        explicit bit_stream_reader(TIter &iter) : iter_(iter) {
+                        }
+
+                        bit_packed_word_type get(std::size_t bits_count) {
+                            bit_packed_word_type result = buffer_;
+                            std::size_t available = fill_;
+
+                            if (available >= bits_count) {
+                                buffer_ = result >> bits_count;
+                                fill_ = available - bits_count;
+                                return result & low_bits_mask(bits_count);
+                            }
+
+                            buffer_ = 0;
+                            fill_ = 0;
+                            for (; available < bits_count; available += 8, ++iter_) {
+                                bit_packed_word_type byte = static_cast<std::uint8_t>(*iter_);
+                                result |= byte << available;
+                                if (available + 8 > bits_count) {
+                                    std::size_t used = bits_count - available;
+                                    buffer_ = byte >> used;
+                                    fill_ = 8 - used;
+                                }
+                            }
+                            return result & low_bits_mask(bits_count);
+                        }
+
+                    private:
+                        TIter &iter_;
+                        bit_packed_word_type buffer_ = 0;
+                        std::size_t fill_ = 0;
+                    };
+
+                    /// @brief Overwrites bits_count bits of the bit stream starting from the given
+                    ///     bit position, leaving the neighbouring bits intact.
+                    template<typename TIter>
+                    void store_bits(TIter data, std::size_t position, bit_packed_word_type word,
+                                    std::size_t bits_count) {
+                        using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                        while (bits_count) {
+                            std::size_t shift = position % 8;
+                            std::size_t taken = std::min<std::size_t>(8 - shift, bits_count);
+                            std::uint8_t mask = static_cast<std::uint8_t>(((1U << taken) - 1) << shift);
+
+                            auto unit = data + static_cast<std::ptrdiff_t>(position / 8);
+                            *unit = static_cast<unit_type>((static_cast<std::uint8_t>(*unit) & ~mask) |
+                                                           (static_cast<std::uint8_t>(word << shift) & mask));
+
+                            word >>= taken;
+                            position += taken;
+                            bits_count -= taken;
+                        }
+                    }
+
+                    template<typename T>
+                    constexpr std::size_t bit_packed_words_count() {
+                        return limb_traits<T>::bits / bit_packed_word_bits +
+                               ((limb_traits<T>::bits % bit_packed_word_bits) ? 1 : 0);
+                    }
+
+                    template<typename T>
+                    constexpr std::size_t bit_packed_word_bits_count(std::size_t word_index) {
+                        return std::min<std::size_t>(bit_packed_word_bits,
+                                                     limb_traits<T>::bits - word_index * bit_packed_word_bits);
+                    }
+
+                    template<typename T, typename TReader>
+                    void read_bit_packed_value(T &value, TReader &reader) {
+                        using traits = limb_traits<T>;
+
+                        typename traits::limb_type *limbs = traits::clear(value);
+                        for (std::size_t i = 0; i < bit_packed_words_count<T>(); ++i) {
+                            insert_word<bit_packed_word_type, traits::limb_count>(
+                                limbs, i, reader.get(bit_packed_word_bits_count<T>(i)));
+                        }
+                        traits::normalize(value);
+                    }
+                }    // namespace detail
+
+                /// @brief Number of bytes count values of type T take when packed back to back.
+                /// @details Every value takes exactly limb_traits<T>::bits bits, only the last byte
+                ///     may be padded.
+                template<typename T>
+                constexpr std::size_t bit_packed_length(std::size_t count) {
+                    static_assert(detail::limb_traits<T>::is_specialized, "bit packing requires direct limb access");
+
+                    return (count * detail::limb_traits<T>::bits + 7) / 8;
+                }
+
+                /// @brief Write values packed back to back without per value padding.
+                /// @details Value i occupies bits [i * bits, (i + 1) * bits) of the output, where bit j
+                ///     is bit (j % 8) of byte (j / 8). The unused bits of the last byte are zeroes.
+                /// @param[in] first Beginning of the values range.
+                /// @param[in] last End of the values range.
+                /// @param[in, out] iter Output iterator.
+                /// @pre The iterator must be valid and can be successfully dereferenced
+                ///      and incremented at least bit_packed_length<T>(count) times.
+                /// @post The iterator is advanced.
+                template<typename TInputIter, typename TIter>
+                void write_bit_packed(TInputIter first, TInputIter last, TIter &iter) {
+                    using value_type = typename std::iterator_traits<TInputIter>::value_type;
+                    using traits = detail::limb_traits<value_type>;
+
+                    static_assert(detail::is_limb_kernel_applicable<value_type, TIter>::value &&
+                                      !std::is_same<typename std::iterator_traits<TIter>::value_type, bool>::value,
+                                  "bit packing writes into byte units");
+
+                    detail::bit_stream_writer<TIter> writer(iter);
+                    for (; first != last; ++first) {
+                        const typename traits::limb_type *limbs = traits::limbs(*first);
+                        for (std::size_t i = 0; i < detail::bit_packed_words_count<value_type>(); ++i) {
+                            std::size_t bits_count = detail::bit_packed_word_bits_count<value_type>(i);
+                            writer.put(
+                                detail::extract_word<detail::bit_packed_word_type, traits::limb_count>(limbs, i) &
+                                    detail::low_bits_mask(bits_count),
+                                bits_count);
+                        }
+                    }
+                    writer.flush();
+                }
+
+                /// @brief Read values packed back to back by write_bit_packed().
+                /// @details The number of values to read is defined by the output range.
+                /// @param[in, out] iter Input iterator.
+                /// @param[in] size Number of bytes available for reading.
+                /// @param[in] first Beginning of the output values range.
+                /// @param[in] last End of the output values range.
+                /// @return Status of read operation.
+                /// @post The iterator is advanced by bit_packed_length<T>(count).
+                template<typename TIter, typename TOutputIter>
+                nil::marshalling::status_type read_bit_packed(TIter &iter, std::size_t size, TOutputIter first,
+                                                              TOutputIter last) {
+                    using value_type = typename std::iterator_traits<TOutputIter>::value_type;
+
+                    std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+                    if (size < bit_packed_length<value_type>(count)) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+
+                    detail::bit_stream_reader<TIter> reader(iter);
+                    for (; first != last; ++first) {
+                        detail::read_bit_packed_value(*first, reader);
+                    }
+                    return nil::marshalling::status_type::success;
+                }
+
+                /// @brief Read a single value of the packed sequence by its index.
+                /// @param[in] data Random access iterator to the beginning of the packed data.
+                /// @param[in] index Index of the value.
+                /// @pre The packed data holds more than index values.
+                template<typename T, typename TIter>
+                T read_bit_packed_element(TIter data, std::size_t index) {
+                    constexpr std::size_t bits = detail::limb_traits<T>::bits;
+
+                    std::size_t position = index * bits;
+                    TIter iter = data + static_cast<std::ptrdiff_t>(position / 8);
+
+                    detail::bit_stream_reader<TIter> reader(iter);
+                    if (position % 8) {
+                        reader.get(position % 8);
+                    }
+
+                    T value;
+                    detail::read_bit_packed_value(value, reader);
+                    return value;
+                }
+
+                /// @brief Overwrite a single value of the packed sequence by its index.
+                /// @details Bits of the neighbouring values are left intact.
+                /// @param[in] value Value to write.
+                /// @param[in] data Random access iterator to the beginning of the packed data.
+                /// @param[in] index Index of the value.
+                /// @pre The packed data holds more than index values.
+                template<typename T, typename TIter>
+                void write_bit_packed_element(const T &value, TIter data, std::size_t index) {
+                    using traits = detail::limb_traits<T>;
+
+                    std::size_t position = index * traits::bits;
+                    const typename traits::limb_type *limbs = traits::limbs(value);
+                    for (std::size_t i = 0; i < detail::bit_packed_words_count<T>(); ++i) {
+                        std::size_t bits_count = detail::bit_packed_word_bits_count<T>(i);
+                        detail::store_bits(
+                            data, position,
+                            detail::extract_word<detail::bit_packed_word_type, traits::limb_count>(limbs, i) &
+                                detail::low_bits_mask(bits_count),
+                            bits_count);
+                        position += bits_count;
+                    }
+                }
+            }    // namespace processing
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_BIT_PACKED_HPP
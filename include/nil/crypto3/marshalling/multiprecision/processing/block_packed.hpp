@@ -0,0 +1,354 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_BLOCK_PACKED_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_BLOCK_PACKED_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <nil/marshalling/endianness.hpp>
+#include <nil/marshalling/status_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/bit_packed.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+
+                /// @brief Number of values sharing a bit width in the block packed layout.
+                constexpr std::size_t block_packed_block_size = 128;
+
+                /// @brief Word the values count is stored in.
+                using block_packed_count_type = std::uint64_t;
+
+                /// @brief Word every block bit width is stored in.
+                using block_packed_width_type = std::uint16_t;
+
+                namespace detail {
+                    /// @brief Number of significant bits of the value, zero for zero.
+                    template<typename T>
+                    std::size_t significant_bits(const T &value) {
+                        return value.is_zero() ? 0 : static_cast<std::size_t>(boost::multiprecision::msb(value)) + 1;
+                    }
+
+                    inline std::size_t block_packed_blocks_count(std::size_t count) {
+                        return count / block_packed_block_size + ((count % block_packed_block_size) ? 1 : 0);
+                    }
+
+                    inline std::size_t block_packed_payload_length(std::size_t count, std::size_t width) {
+                        return (count * width + 7) / 8;
+                    }
+
+                    template<typename TInputIter>
+                    std::size_t block_packed_width(TInputIter first, TInputIter last) {
+                        std::size_t result = 0;
+                        for (; first != last; ++first) {
+                            result = std::max(result, significant_bits(*first));
+                        }
+                        return result;
+                    }
+
+                    template<typename T, typename TReader>
+                    void read_block_packed_value(T &value, std::size_t width, TReader &reader) {
+                        using traits = limb_traits<T>;
+
+                        typename traits::limb_type *limbs = traits::clear(value);
+                        for (std::size_t i = 0; i * bit_packed_word_bits < width; ++i) {
+                            insert_word<bit_packed_word_type, traits::limb_count>(
+                                limbs, i, reader.get(std::min(bit_packed_word_bits, width - i * bit_packed_word_bits)));
+                        }
+                        traits::normalize(value);
+                    }
+                }    // namespace detail
+
+                /// @brief Index of the blocks of a layout written by write_block_packed().
+                /// @details Holds the widths table and the offsets of the block payloads, so that
+                ///     the table is parsed once and any number of blocks is then read without
+                ///     going through it again.
+                /// @tparam T Type of the values.
+                template<typename T>
+                class block_packed_index {
+                public:
+                    /// @brief Read the values count and the widths table.
+                    /// @details Checks that the payloads of all the blocks fit into size bytes.
+                    /// @param[in, out] iter Random access iterator to the beginning of the layout.
+                    /// @param[in] size Number of bytes available for reading.
+                    /// @return not_enough_data if the buffer is shorter than the layout,
+                    ///     invalid_msg_data if a block width exceeds the type width, success
+                    ///     otherwise. On failure the index is left empty.
+                    /// @post The iterator is advanced past the table.
+                    template<typename Endianness, typename TIter>
+                    nil::marshalling::status_type read(TIter &iter, std::size_t size) {
+                        nil::marshalling::status_type status = read_table<Endianness>(iter, size);
+                        if (status != nil::marshalling::status_type::success) {
+                            count_ = 0;
+                            widths_.clear();
+                            offsets_.assign(1, 0);
+                        }
+                        return status;
+                    }
+
+                    /// @brief Number of values of the layout.
+                    std::size_t count() const {
+                        return count_;
+                    }
+
+                    /// @brief Number of blocks of the layout.
+                    std::size_t blocks_count() const {
+                        return widths_.size();
+                    }
+
+                    /// @brief Number of values of the block.
+                    /// @pre block_index < blocks_count().
+                    std::size_t block_count(std::size_t block_index) const {
+                        return std::min(block_packed_block_size, count_ - block_index * block_packed_block_size);
+                    }
+
+                    /// @brief Bit width of the values of the block.
+                    /// @pre block_index < blocks_count().
+                    std::size_t block_width(std::size_t block_index) const {
+                        return widths_[block_index];
+                    }
+
+                    /// @brief Number of bytes the whole layout takes.
+                    std::size_t length() const {
+                        return table_length() + offsets_.back();
+                    }
+
+                    /// @brief Read the values of a single block.
+                    /// @param[in] data Random access iterator to the beginning of the layout the index
+                    ///     has been read from.
+                    /// @param[in] block_index Index of the block, value i belongs to the block
+                    ///     i / block_packed_block_size.
+                    /// @param[out] out Output iterator receiving the values of the block.
+                    /// @return invalid_msg_data if the block doesn't exist, success otherwise.
+                    template<typename TIter, typename TOutputIter>
+                    nil::marshalling::status_type read_block(TIter data, std::size_t block_index,
+                                                             TOutputIter out) const {
+                        if (block_index >= widths_.size()) {
+                            return nil::marshalling::status_type::invalid_msg_data;
+                        }
+
+                        data += static_cast<std::ptrdiff_t>(table_length() + offsets_[block_index]);
+                        detail::bit_stream_reader<TIter> reader(data);
+                        for (std::size_t i = block_count(block_index); i > 0; --i, ++out) {
+                            T value;
+                            detail::read_block_packed_value(value, widths_[block_index], reader);
+                            *out = value;
+                        }
+                        return nil::marshalling::status_type::success;
+                    }
+
+                private:
+                    std::size_t table_length() const {
+                        return sizeof(block_packed_count_type) + widths_.size() * sizeof(block_packed_width_type);
+                    }
+
+                    template<typename Endianness, typename TIter>
+                    nil::marshalling::status_type read_table(TIter &iter, std::size_t size) {
+                        if (size < sizeof(block_packed_count_type)) {
+                            return nil::marshalling::status_type::not_enough_data;
+                        }
+                        block_packed_count_type count = detail::read_word<Endianness, block_packed_count_type>(iter);
+                        size -= sizeof(block_packed_count_type);
+
+                        if (count / block_packed_block_size > size / sizeof(block_packed_width_type)) {
+                            return nil::marshalling::status_type::not_enough_data;
+                        }
+                        count_ = static_cast<std::size_t>(count);
+                        std::size_t blocks_count = detail::block_packed_blocks_count(count_);
+                        if (blocks_count > size / sizeof(block_packed_width_type)) {
+                            return nil::marshalling::status_type::not_enough_data;
+                        }
+                        size -= blocks_count * sizeof(block_packed_width_type);
+
+                        widths_.resize(blocks_count);
+                        offsets_.assign(blocks_count + 1, 0);
+                        for (std::size_t i = 0; i < blocks_count; ++i) {
+                            widths_[i] = detail::read_word<Endianness, block_packed_width_type>(iter);
+                            if (widths_[i] > detail::limb_traits<T>::bits) {
+                                return nil::marshalling::status_type::invalid_msg_data;
+                            }
+                            offsets_[i + 1] =
+                                offsets_[i] + detail::block_packed_payload_length(block_count(i), widths_[i]);
+                        }
+                        if (offsets_.back() > size) {
+                            return nil::marshalling::status_type::not_enough_data;
+                        }
+                        return nil::marshalling::status_type::success;
+                    }
+
+                    std::size_t count_ = 0;
+                    std::vector<block_packed_width_type> widths_;
+                    // Offsets of the block payloads past the table, the last one is their total length
+                    std::vector<std::size_t> offsets_ = std::vector<std::size_t>(1, 0);
+                };
+
+                /// @brief Number of bytes the values take in the block packed layout.
+                template<typename TInputIter>
+                std::size_t block_packed_length(TInputIter first, TInputIter last) {
+                    std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+                    std::size_t result = sizeof(block_packed_count_type) +
+                                         detail::block_packed_blocks_count(count) * sizeof(block_packed_width_type);
+                    while (first != last) {
+                        std::size_t block_count =
+                            std::min<std::size_t>(block_packed_block_size,
+                                                  static_cast<std::size_t>(std::distance(first, last)));
+                        TInputIter block_last = std::next(first, static_cast<std::ptrdiff_t>(block_count));
+                        result += detail::block_packed_payload_length(block_count,
+                                                                      detail::block_packed_width(first, block_last));
+                        first = block_last;
+                    }
+                    return result;
+                }
+
+                /// @brief Write values bit packed at the width of the widest one in their block.
+                /// @details Values are split into blocks of block_packed_block_size. The layout is
+                ///     the values count, the table of the block bit widths and then the block
+                ///     payloads. A block payload is its values packed back to back at the block
+                ///     width, as by write_bit_packed(), and padded to a whole byte. A block holding
+                ///     a wide value falls back to the full width of the type, blocks of small
+                ///     values take just their bits. The count and widths are written in the given
+                ///     endianness. The table gives the offset of every block up front, so blocks
+                ///     can be decoded independently, see read_block_packed_block().
+                /// @param[in] first Beginning of the values range.
+                /// @param[in] last End of the values range.
+                /// @param[in, out] iter Output iterator.
+                /// @pre The iterator must be valid and can be successfully dereferenced
+                ///      and incremented at least block_packed_length(first, last) times.
+                /// @post The iterator is advanced.
+                template<typename Endianness, typename TInputIter, typename TIter>
+                void write_block_packed(TInputIter first, TInputIter last, TIter &iter) {
+                    using value_type = typename std::iterator_traits<TInputIter>::value_type;
+                    using traits = detail::limb_traits<value_type>;
+
+                    static_assert(detail::is_limb_kernel_applicable<value_type, TIter>::value &&
+                                      !std::is_same<typename std::iterator_traits<TIter>::value_type, bool>::value,
+                                  "block packing writes into byte units");
+
+                    std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+                    std::vector<std::size_t> widths;
+                    widths.reserve(detail::block_packed_blocks_count(count));
+                    for (TInputIter block_first = first; block_first != last;) {
+                        TInputIter block_last = std::next(
+                            block_first, static_cast<std::ptrdiff_t>(std::min<std::size_t>(
+                                             block_packed_block_size,
+                                             static_cast<std::size_t>(std::distance(block_first, last)))));
+                        widths.push_back(detail::block_packed_width(block_first, block_last));
+                        block_first = block_last;
+                    }
+
+                    detail::write_word<Endianness>(static_cast<block_packed_count_type>(count), iter);
+                    for (std::size_t width : widths) {
+                        detail::write_word<Endianness>(static_cast<block_packed_width_type>(width), iter);
+                    }
+
+                    for (std::size_t i = 0; first != last; ++i) {
+                        detail::bit_stream_writer<TIter> writer(iter);
+                        for (std::size_t j = 0; j < block_packed_block_size && first != last; ++j, ++first) {
+                            const typename traits::limb_type *limbs = traits::limbs(*first);
+                            for (std::size_t k = 0; k * detail::bit_packed_word_bits < widths[i]; ++k) {
+                                std::size_t bits_count = std::min(detail::bit_packed_word_bits,
+                                                                  widths[i] - k * detail::bit_packed_word_bits);
+                                writer.put(
+                                    detail::extract_word<detail::bit_packed_word_type, traits::limb_count>(limbs, k) &
+                                        detail::low_bits_mask(bits_count),
+                                    bits_count);
+                            }
+                        }
+                        writer.flush();
+                    }
+                }
+
+                /// @brief Read values written by write_block_packed().
+                /// @param[in, out] iter Random access input iterator.
+                /// @param[in] size Number of bytes available for reading.
+                /// @param[in] first Beginning of the output values range.
+                /// @param[in] last End of the output values range.
+                /// @return not_enough_data if the buffer is shorter than the layout, invalid_msg_data
+                ///     if the stored count differs from the output range size or a block width
+                ///     exceeds the type width, success otherwise.
+                /// @post The iterator is advanced past the layout.
+                template<typename Endianness, typename TIter, typename TOutputIter>
+                nil::marshalling::status_type read_block_packed(TIter &iter, std::size_t size, TOutputIter first,
+                                                                TOutputIter last) {
+                    using value_type = typename std::iterator_traits<TOutputIter>::value_type;
+
+                    TIter data = iter;
+                    block_packed_index<value_type> index;
+                    nil::marshalling::status_type status = index.template read<Endianness>(data, size);
+                    if (status != nil::marshalling::status_type::success) {
+                        return status;
+                    }
+                    if (index.count() != static_cast<std::size_t>(std::distance(first, last))) {
+                        return nil::marshalling::status_type::invalid_msg_data;
+                    }
+
+                    for (std::size_t i = 0; i < index.blocks_count(); ++i) {
+                        detail::bit_stream_reader<TIter> reader(data);
+                        for (std::size_t j = 0; j < block_packed_block_size && first != last; ++j, ++first) {
+                            detail::read_block_packed_value(*first, index.block_width(i), reader);
+                        }
+                    }
+
+                    iter = data;
+                    return nil::marshalling::status_type::success;
+                }
+
+                /// @brief Read a single block of values written by write_block_packed().
+                /// @details Parses the widths table on every call, use block_packed_index to read
+                ///     several blocks of the same layout.
+                /// @param[in] data Random access iterator to the beginning of the layout.
+                /// @param[in] size Number of bytes available for reading.
+                /// @param[in] block_index Index of the block, value i belongs to the block
+                ///     i / block_packed_block_size.
+                /// @param[out] out Output iterator receiving the values of the block.
+                /// @return not_enough_data if the buffer is shorter than the layout, invalid_msg_data
+                ///     if the block doesn't exist or a block width exceeds the type width, success
+                ///     otherwise.
+                template<typename Endianness, typename T, typename TIter, typename TOutputIter>
+                nil::marshalling::status_type read_block_packed_block(TIter data, std::size_t size,
+                                                                      std::size_t block_index, TOutputIter out) {
+                    block_packed_index<T> index;
+                    TIter iter = data;
+                    nil::marshalling::status_type status = index.template read<Endianness>(iter, size);
+                    if (status != nil::marshalling::status_type::success) {
+                        return status;
+                    }
+                    return index.read_block(data, block_index, out);
+                }
+            }    // namespace processing
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_BLOCK_PACKED_HPP
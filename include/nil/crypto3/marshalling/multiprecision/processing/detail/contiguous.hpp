@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_DETAIL_CONTIGUOUS_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_DETAIL_CONTIGUOUS_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+                namespace detail {
+                    /// @brief Checks whether the unit is a byte wide integral, bool excluded.
+                    template<typename TUnit>
+                    struct is_byte_unit
+                        : std::integral_constant<bool, !std::is_same<TUnit, bool>::value &&
+                                                           std::is_integral<TUnit>::value && sizeof(TUnit) == 1> { };
+
+                    template<>
+                    struct is_byte_unit<void> : std::false_type { };
+
+                    /// @brief Checks whether the iterator refers to contiguous storage of bytes,
+                    ///     so that it may be turned into a plain byte pointer.
+                    /// @details Relies on std::contiguous_iterator where concepts are available,
+                    ///     otherwise recognizes pointers and std::vector iterators.
+                    template<typename TIter>
+                    struct is_contiguous_byte_iterator {
+                        using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                        static constexpr bool is_byte = is_byte_unit<unit_type>::value;
+
+                        // Keeps std::vector from being instantiated for void or bool units
+                        using byte_type = typename std::conditional<is_byte, unit_type, std::uint8_t>::type;
+
+                        static constexpr bool value =
+                            is_byte &&
+#if defined(__cpp_lib_concepts)
+                            (std::contiguous_iterator<TIter> ||
+#else
+                            (std::is_pointer<TIter>::value ||
+#endif
+                             std::is_same<TIter, typename std::vector<byte_type>::iterator>::value ||
+                             std::is_same<TIter, typename std::vector<byte_type>::const_iterator>::value);
+                    };
+                }    // namespace detail
+            }        // namespace processing
+        }            // namespace marshalling
+    }                // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_DETAIL_CONTIGUOUS_HPP
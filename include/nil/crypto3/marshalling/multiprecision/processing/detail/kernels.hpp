@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_DETAIL_KERNELS_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_DETAIL_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+                namespace detail {
+                    /// @brief Writes the bytes_count least significant bytes of the limbs in big
+                    ///     endian order.
+                    /// @details Unlike the limb kernels templated on the value type, the width is a
+                    ///     run time parameter, so all the widths share a single copy of the code per
+                    ///     limb type. With CRYPTO3_MARSHALLING_COMPILED_KERNELS defined the copy
+                    ///     comes from the precompiled kernels library.
+                    /// @pre bytes_count <= limbs count * sizeof(TLimb).
+                    /// @return Pointer past the last written byte.
+                    template<typename TLimb>
+                    std::uint8_t *write_limbs_bytes_big_endian(const TLimb *limbs, std::size_t bytes_count,
+                                                               std::uint8_t *out) {
+                        for (std::size_t i = bytes_count; i > 0; --i, ++out) {
+                            *out = static_cast<std::uint8_t>(limbs[(i - 1) / sizeof(TLimb)] >>
+                                                             (((i - 1) % sizeof(TLimb)) * 8));
+                        }
+                        return out;
+                    }
+
+                    /// @brief Writes the bytes_count least significant bytes of the limbs in little
+                    ///     endian order.
+                    /// @pre bytes_count <= limbs count * sizeof(TLimb).
+                    /// @return Pointer past the last written byte.
+                    template<typename TLimb>
+                    std::uint8_t *write_limbs_bytes_little_endian(const TLimb *limbs, std::size_t bytes_count,
+                                                                  std::uint8_t *out) {
+                        for (std::size_t i = 0; i < bytes_count; ++i, ++out) {
+                            *out = static_cast<std::uint8_t>(limbs[i / sizeof(TLimb)] >> ((i % sizeof(TLimb)) * 8));
+                        }
+                        return out;
+                    }
+
+                    /// @brief Reads bytes_count bytes in big endian order into the least
+                    ///     significant bytes of the limbs.
+                    /// @pre Limbs are zeroed, bytes_count <= limbs count * sizeof(TLimb).
+                    /// @return Pointer past the last read byte.
+                    template<typename TLimb>
+                    const std::uint8_t *read_limbs_bytes_big_endian(const std::uint8_t *in, std::size_t bytes_count,
+                                                                    TLimb *limbs) {
+                        for (std::size_t i = bytes_count; i > 0; --i, ++in) {
+                            limbs[(i - 1) / sizeof(TLimb)] |= static_cast<TLimb>(*in)
+                                                              << (((i - 1) % sizeof(TLimb)) * 8);
+                        }
+                        return in;
+                    }
+
+                    /// @brief Reads bytes_count bytes in little endian order into the least
+                    ///     significant bytes of the limbs.
+                    /// @pre Limbs are zeroed, bytes_count <= limbs count * sizeof(TLimb).
+                    /// @return Pointer past the last read byte.
+                    template<typename TLimb>
+                    const std::uint8_t *read_limbs_bytes_little_endian(const std::uint8_t *in, std::size_t bytes_count,
+                                                                       TLimb *limbs) {
+                        for (std::size_t i = 0; i < bytes_count; ++i, ++in) {
+                            limbs[i / sizeof(TLimb)] |= static_cast<TLimb>(*in) << ((i % sizeof(TLimb)) * 8);
+                        }
+                        return in;
+                    }
+
+#if defined(CRYPTO3_MARSHALLING_COMPILED_KERNELS)
+                    // Instantiated once in the precompiled kernels library for every unsigned type
+                    // used as a limb.
+                    extern template std::uint8_t *write_limbs_bytes_big_endian(const unsigned *, std::size_t,
+                                                                               std::uint8_t *);
+                    extern template std::uint8_t *write_limbs_bytes_big_endian(const unsigned long *, std::size_t,
+                                                                               std::uint8_t *);
+                    extern template std::uint8_t *write_limbs_bytes_big_endian(const unsigned long long *,
+                                                                               std::size_t, std::uint8_t *);
+                    extern template std::uint8_t *write_limbs_bytes_little_endian(const unsigned *, std::size_t,
+                                                                                  std::uint8_t *);
+                    extern template std::uint8_t *write_limbs_bytes_little_endian(const unsigned long *, std::size_t,
+                                                                                  std::uint8_t *);
+                    extern template std::uint8_t *write_limbs_bytes_little_endian(const unsigned long long *,
+                                                                                  std::size_t, std::uint8_t *);
+                    extern template const std::uint8_t *read_limbs_bytes_big_endian(const std::uint8_t *, std::size_t,
+                                                                                    unsigned *);
+                    extern template const std::uint8_t *read_limbs_bytes_big_endian(const std::uint8_t *, std::size_t,
+                                                                                    unsigned long *);
+                    extern template const std::uint8_t *read_limbs_bytes_big_endian(const std::uint8_t *, std::size_t,
+                                                                                    unsigned long long *);
+                    extern template const std::uint8_t *read_limbs_bytes_little_endian(const std::uint8_t *,
+                                                                                       std::size_t, unsigned *);
+                    extern template const std::uint8_t *read_limbs_bytes_little_endian(const std::uint8_t *,
+                                                                                       std::size_t, unsigned long *);
+                    extern template const std::uint8_t *read_limbs_bytes_little_endian(const std::uint8_t *,
+                                                                                       std::size_t,
+                                                                                       unsigned long long *);
+#endif
+                }    // namespace detail
+            }        // namespace processing
+        }            // namespace marshalling
+    }                // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_DETAIL_KERNELS_HPP
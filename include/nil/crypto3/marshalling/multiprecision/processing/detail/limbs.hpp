@@ -0,0 +1,352 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_DETAIL_LIMBS_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_DETAIL_LIMBS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <boost/multiprecision/number.hpp>
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/contiguous.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/kernels.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+                namespace detail {
+
+                    /// @brief Direct access to the limbs of an integral value.
+                    /// @details Specialized only for backends whose limb storage is always fully
+                    ///     populated, so that kernels may iterate over it with bounds depending
+                    ///     on the type width only.
+                    template<typename T>
+                    struct limb_traits {
+                        static constexpr bool is_specialized = false;
+                    };
+
+                    /// @brief Checks whether the backend keeps track of the number of limbs in use.
+                    template<typename Backend, typename = void>
+                    struct has_resizable_limbs : std::false_type { };
+
+                    template<typename Backend>
+                    struct has_resizable_limbs<
+                        Backend, decltype(std::declval<Backend &>().resize(0u, 0u), void())> : std::true_type { };
+
+                    template<unsigned Bits, boost::multiprecision::expression_template_option ExpressionTemplates>
+                    struct limb_traits<boost::multiprecision::number<
+                        boost::multiprecision::backends::cpp_int_modular_backend<Bits>, ExpressionTemplates>> {
+
+                        using backend_type = boost::multiprecision::backends::cpp_int_modular_backend<Bits>;
+                        using value_type = boost::multiprecision::number<backend_type, ExpressionTemplates>;
+                        using limb_type = typename std::remove_cv<typename std::remove_pointer<decltype(
+                            std::declval<const backend_type &>().limbs())>::type>::type;
+
+                        static constexpr bool is_specialized = true;
+                        static constexpr std::size_t bits = Bits;
+                        static constexpr std::size_t limb_bits = std::numeric_limits<limb_type>::digits;
+                        static constexpr std::size_t limb_count = Bits / limb_bits + ((Bits % limb_bits) ? 1 : 0);
+
+                        static const limb_type *limbs(const value_type &value) {
+                            return value.backend().limbs();
+                        }
+
+                        static limb_type *limbs(value_type &value) {
+                            return value.backend().limbs();
+                        }
+
+                        /// @brief Must be called after the limbs were modified directly.
+                        static void normalize(value_type &value) {
+                            value.backend().normalize();
+                        }
+
+                        /// @brief Zero all the limb_count limbs of value, so that they may be set
+                        ///     directly.
+                        static limb_type *clear(value_type &value) {
+                            value = 0;
+                            if constexpr (has_resizable_limbs<backend_type>::value) {
+                                value.backend().resize(limb_count, limb_count);
+                            }
+                            limb_type *result = limbs(value);
+                            std::fill(result, result + limb_count, limb_type(0));
+                            return result;
+                        }
+                    };
+
+                    /// @brief Number of bits a single unit of the given type carries.
+                    template<typename TUnit>
+                    struct unit_bits
+                        : std::integral_constant<std::size_t,
+                                                 std::is_same<TUnit, bool>::value ? 1 : sizeof(TUnit) * 8> { };
+
+                    /// @brief Checks whether limb kernels may be used to write T through TIter.
+                    /// @details Only bit and byte units are handled, which are the ones for which
+                    ///     a unit always lies within a single limb.
+                    template<typename T, typename TIter, typename = void>
+                    struct is_limb_kernel_applicable : std::false_type { };
+
+                    template<typename T, typename TIter>
+                    struct is_limb_kernel_applicable<
+                        T, TIter,
+                        typename std::enable_if<limb_traits<T>::is_specialized &&
+                                                !std::is_void<typename std::iterator_traits<TIter>::value_type>::value>::type>
+                        : std::integral_constant<
+                              bool, std::is_same<typename std::iterator_traits<TIter>::value_type, bool>::value ||
+                                        (std::is_integral<typename std::iterator_traits<TIter>::value_type>::value &&
+                                         sizeof(typename std::iterator_traits<TIter>::value_type) == 1)> { };
+
+                    /// @brief Extracts the unit with the given index (counted from the least
+                    ///     significant one) out of the limbs.
+                    template<std::size_t UnitBits, typename TLimb>
+                    inline TLimb extract_unit(const TLimb *limbs, std::size_t index) {
+                        constexpr std::size_t limb_bits = std::numeric_limits<TLimb>::digits;
+                        constexpr std::size_t units_per_limb = limb_bits / UnitBits;
+                        constexpr TLimb mask = static_cast<TLimb>(~TLimb(0)) >> (limb_bits - UnitBits);
+
+                        static_assert(limb_bits % UnitBits == 0, "unit must not cross limb boundaries");
+
+                        return (limbs[index / units_per_limb] >> ((index % units_per_limb) * UnitBits)) & mask;
+                    }
+
+                    /// @brief Extracts the word of TWord width with the given index (counted from the
+                    ///     least significant one) out of the limbs.
+                    /// @details Words may be wider than limbs, limbs past LimbCount are read as zeroes.
+                    template<typename TWord, std::size_t LimbCount, typename TLimb>
+                    inline TWord extract_word(const TLimb *limbs, std::size_t index) {
+                        constexpr std::size_t limb_bits = std::numeric_limits<TLimb>::digits;
+                        constexpr std::size_t word_bits = std::numeric_limits<TWord>::digits;
+
+                        if constexpr (word_bits <= limb_bits) {
+                            return static_cast<TWord>(extract_unit<word_bits>(limbs, index));
+                        } else {
+                            constexpr std::size_t limbs_per_word = word_bits / limb_bits;
+
+                            TWord result = 0;
+                            for (std::size_t i = 0; i < limbs_per_word; ++i) {
+                                std::size_t limb_index = index * limbs_per_word + i;
+                                if (limb_index < LimbCount) {
+                                    result |= static_cast<TWord>(limbs[limb_index]) << (i * limb_bits);
+                                }
+                            }
+                            return result;
+                        }
+                    }
+
+                    /// @brief Puts the word of TWord width to the given index (counted from the least
+                    ///     significant one) of the limbs.
+                    /// @pre Limbs covered by the word are zeroed.
+                    template<typename TWord, std::size_t LimbCount, typename TLimb>
+                    inline void insert_word(TLimb *limbs, std::size_t index, TWord word) {
+                        constexpr std::size_t limb_bits = std::numeric_limits<TLimb>::digits;
+                        constexpr std::size_t word_bits = std::numeric_limits<TWord>::digits;
+
+                        if constexpr (word_bits <= limb_bits) {
+                            constexpr std::size_t words_per_limb = limb_bits / word_bits;
+
+                            limbs[index / words_per_limb] |= static_cast<TLimb>(word)
+                                                             << ((index % words_per_limb) * word_bits);
+                        } else {
+                            constexpr std::size_t limbs_per_word = word_bits / limb_bits;
+
+                            for (std::size_t i = 0; i < limbs_per_word; ++i) {
+                                std::size_t limb_index = index * limbs_per_word + i;
+                                if (limb_index < LimbCount) {
+                                    limbs[limb_index] = static_cast<TLimb>(word >> (i * limb_bits));
+                                }
+                            }
+                        }
+                    }
+
+                    /// @brief Writes word of TWord width as sizeof(TWord) bytes in the given order.
+                    template<typename Endianness, typename TWord, typename TIter>
+                    inline void write_word(TWord word, TIter &iter) {
+                        using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                        for (std::size_t i = 0; i < sizeof(TWord); ++i, ++iter) {
+                            std::size_t byte_index =
+                                std::is_same<Endianness, nil::marshalling::endian::big_endian>::value ?
+                                    sizeof(TWord) - 1 - i :
+                                    i;
+                            *iter = static_cast<unit_type>(word >> (byte_index * 8));
+                        }
+                    }
+
+                    /// @brief Reads word of TWord width from sizeof(TWord) bytes in the given order.
+                    template<typename Endianness, typename TWord, typename TIter>
+                    inline TWord read_word(TIter &iter) {
+                        TWord word = 0;
+                        for (std::size_t i = 0; i < sizeof(TWord); ++i, ++iter) {
+                            std::size_t byte_index =
+                                std::is_same<Endianness, nil::marshalling::endian::big_endian>::value ?
+                                    sizeof(TWord) - 1 - i :
+                                    i;
+                            word |= static_cast<TWord>(static_cast<std::uint8_t>(*iter)) << (byte_index * 8);
+                        }
+                        return word;
+                    }
+
+                    /// @brief Writes TSize bits of value in big endian units order in one forward
+                    ///     sweep over the output.
+                    /// @details Padding units are produced by the same loop as the payload ones:
+                    ///     there are no branches depending on the value, so the amount of work
+                    ///     depends on the type width only.
+                    /// @return Iterator past the last written unit.
+                    template<std::size_t TSize, typename T, typename TIter>
+                    TIter write_limbs_big_endian(const T &value, TIter iter) {
+                        using traits = limb_traits<T>;
+                        using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                        constexpr std::size_t chunk_bits = unit_bits<unit_type>::value;
+                        constexpr std::size_t chunks_count = (TSize / chunk_bits) + ((TSize % chunk_bits) ? 1 : 0);
+
+                        static_assert(chunks_count * chunk_bits <= traits::limb_count * traits::limb_bits,
+                                      "value does not fit into the limbs");
+
+                        const typename traits::limb_type *limbs = traits::limbs(value);
+#if defined(CRYPTO3_MARSHALLING_COMPILED_KERNELS)
+                        if constexpr (chunk_bits == 8 && is_contiguous_byte_iterator<TIter>::value) {
+                            std::uint8_t *out = reinterpret_cast<std::uint8_t *>(&*iter);
+                            write_limbs_bytes_big_endian(limbs, chunks_count, out);
+                            return iter + chunks_count;
+                        }
+#endif
+                        for (std::size_t i = chunks_count; i > 0; --i, ++iter) {
+                            *iter = static_cast<unit_type>(extract_unit<chunk_bits>(limbs, i - 1));
+                        }
+                        return iter;
+                    }
+
+                    /// @brief Writes TSize bits of value in little endian units order in one
+                    ///     forward sweep over the output.
+                    /// @return Iterator past the last written unit.
+                    template<std::size_t TSize, typename T, typename TIter>
+                    TIter write_limbs_little_endian(const T &value, TIter iter) {
+                        using traits = limb_traits<T>;
+                        using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                        constexpr std::size_t chunk_bits = unit_bits<unit_type>::value;
+                        constexpr std::size_t chunks_count = (TSize / chunk_bits) + ((TSize % chunk_bits) ? 1 : 0);
+
+                        static_assert(chunks_count * chunk_bits <= traits::limb_count * traits::limb_bits,
+                                      "value does not fit into the limbs");
+
+                        const typename traits::limb_type *limbs = traits::limbs(value);
+#if defined(CRYPTO3_MARSHALLING_COMPILED_KERNELS)
+                        if constexpr (chunk_bits == 8 && is_contiguous_byte_iterator<TIter>::value) {
+                            std::uint8_t *out = reinterpret_cast<std::uint8_t *>(&*iter);
+                            write_limbs_bytes_little_endian(limbs, chunks_count, out);
+                            return iter + chunks_count;
+                        }
+#endif
+                        for (std::size_t i = 0; i < chunks_count; ++i, ++iter) {
+                            *iter = static_cast<unit_type>(extract_unit<chunk_bits>(limbs, i));
+                        }
+                        return iter;
+                    }
+
+                    /// @brief Reads TSize bits of value in big endian units order straight into
+                    ///     its limbs.
+                    /// @return Iterator past the last read unit.
+                    template<std::size_t TSize, typename T, typename TIter>
+                    TIter read_limbs_big_endian(T &value, TIter iter) {
+                        using traits = limb_traits<T>;
+                        using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                        constexpr std::size_t chunk_bits = unit_bits<unit_type>::value;
+                        constexpr std::size_t chunks_count = (TSize / chunk_bits) + ((TSize % chunk_bits) ? 1 : 0);
+
+                        static_assert(chunks_count * chunk_bits <= traits::limb_count * traits::limb_bits,
+                                      "value does not fit into the limbs");
+
+                        typename traits::limb_type *limbs = traits::clear(value);
+#if defined(CRYPTO3_MARSHALLING_COMPILED_KERNELS)
+                        if constexpr (chunk_bits == 8 && is_contiguous_byte_iterator<TIter>::value) {
+                            const std::uint8_t *in = reinterpret_cast<const std::uint8_t *>(&*iter);
+                            read_limbs_bytes_big_endian(in, chunks_count, limbs);
+                            traits::normalize(value);
+                            return iter + chunks_count;
+                        }
+#endif
+                        for (std::size_t i = chunks_count; i > 0; --i, ++iter) {
+                            insert_word<unit_type, traits::limb_count>(limbs, i - 1, static_cast<unit_type>(*iter));
+                        }
+                        traits::normalize(value);
+                        return iter;
+                    }
+
+                    /// @brief Reads TSize bits of value in little endian units order straight into
+                    ///     its limbs.
+                    /// @return Iterator past the last read unit.
+                    template<std::size_t TSize, typename T, typename TIter>
+                    TIter read_limbs_little_endian(T &value, TIter iter) {
+                        using traits = limb_traits<T>;
+                        using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                        constexpr std::size_t chunk_bits = unit_bits<unit_type>::value;
+                        constexpr std::size_t chunks_count = (TSize / chunk_bits) + ((TSize % chunk_bits) ? 1 : 0);
+
+                        static_assert(chunks_count * chunk_bits <= traits::limb_count * traits::limb_bits,
+                                      "value does not fit into the limbs");
+
+                        typename traits::limb_type *limbs = traits::clear(value);
+#if defined(CRYPTO3_MARSHALLING_COMPILED_KERNELS)
+                        if constexpr (chunk_bits == 8 && is_contiguous_byte_iterator<TIter>::value) {
+                            const std::uint8_t *in = reinterpret_cast<const std::uint8_t *>(&*iter);
+                            read_limbs_bytes_little_endian(in, chunks_count, limbs);
+                            traits::normalize(value);
+                            return iter + chunks_count;
+                        }
+#endif
+                        for (std::size_t i = 0; i < chunks_count; ++i, ++iter) {
+                            insert_word<unit_type, traits::limb_count>(limbs, i, static_cast<unit_type>(*iter));
+                        }
+                        traits::normalize(value);
+                        return iter;
+                    }
+
+                    template<typename Endianness, typename T, typename TIter>
+                    TIter read_limbs(T &value, TIter iter) {
+                        if constexpr (std::is_same<Endianness, nil::marshalling::endian::big_endian>::value) {
+                            return read_limbs_big_endian<limb_traits<T>::bits>(value, iter);
+                        } else {
+                            return read_limbs_little_endian<limb_traits<T>::bits>(value, iter);
+                        }
+                    }
+                }    // namespace detail
+            }        // namespace processing
+        }            // namespace marshalling
+    }                // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_DETAIL_LIMBS_HPP
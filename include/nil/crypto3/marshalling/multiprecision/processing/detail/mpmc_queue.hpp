@@ -0,0 +1,131 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_DETAIL_MPMC_QUEUE_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_DETAIL_MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+                namespace detail {
+
+                    /// @brief Bounded lock-free multi-producer multi-consumer queue.
+                    /// @details Every cell carries a sequence number telling whether it's ready to be
+                    ///     written or read at the current lap, so producers and consumers only contend on
+                    ///     a single compare-and-swap of their position. Capacity is rounded up to a power
+                    ///     of two.
+                    template<typename T>
+                    class mpmc_queue {
+                    public:
+                        explicit mpmc_queue(std::size_t capacity) {
+                            capacity_ = 2;
+                            while (capacity_ < capacity) {
+                                capacity_ <<= 1;
+                            }
+                            cells_.reset(new cell[capacity_]);
+                            for (std::size_t i = 0; i < capacity_; ++i) {
+                                cells_[i].sequence.store(i, std::memory_order_relaxed);
+                            }
+                        }
+
+                        mpmc_queue(const mpmc_queue &) = delete;
+                        mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+                        std::size_t capacity() const {
+                            return capacity_;
+                        }
+
+                        /// @brief Push the value, false if the queue is full.
+                        bool try_push(T &&value) {
+                            std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+                            for (;;) {
+                                cell &current = cells_[position & (capacity_ - 1)];
+                                std::size_t sequence = current.sequence.load(std::memory_order_acquire);
+                                std::ptrdiff_t difference =
+                                    static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+                                if (difference == 0) {
+                                    if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                                                std::memory_order_relaxed)) {
+                                        current.value = std::move(value);
+                                        current.sequence.store(position + 1, std::memory_order_release);
+                                        return true;
+                                    }
+                                } else if (difference < 0) {
+                                    return false;
+                                } else {
+                                    position = enqueue_position_.load(std::memory_order_relaxed);
+                                }
+                            }
+                        }
+
+                        /// @brief Pop the oldest value, false if the queue is empty.
+                        bool try_pop(T &value) {
+                            std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+                            for (;;) {
+                                cell &current = cells_[position & (capacity_ - 1)];
+                                std::size_t sequence = current.sequence.load(std::memory_order_acquire);
+                                std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) -
+                                                            static_cast<std::ptrdiff_t>(position + 1);
+                                if (difference == 0) {
+                                    if (dequeue_position_.compare_exchange_weak(position, position + 1,
+                                                                                std::memory_order_relaxed)) {
+                                        value = std::move(current.value);
+                                        current.value = T();
+                                        current.sequence.store(position + capacity_, std::memory_order_release);
+                                        return true;
+                                    }
+                                } else if (difference < 0) {
+                                    return false;
+                                } else {
+                                    position = dequeue_position_.load(std::memory_order_relaxed);
+                                }
+                            }
+                        }
+
+                    private:
+                        struct cell {
+                            std::atomic<std::size_t> sequence;
+                            T value;
+                        };
+
+                        static constexpr std::size_t cache_line_size = 64;
+
+                        std::unique_ptr<cell[]> cells_;
+                        std::size_t capacity_;
+                        alignas(cache_line_size) std::atomic<std::size_t> enqueue_position_ {0};
+                        alignas(cache_line_size) std::atomic<std::size_t> dequeue_position_ {0};
+                    };
+                }    // namespace detail
+            }        // namespace processing
+        }            // namespace marshalling
+    }                // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_DETAIL_MPMC_QUEUE_HPP
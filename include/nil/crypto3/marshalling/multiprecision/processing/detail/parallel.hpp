@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_DETAIL_PARALLEL_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_DETAIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+                namespace detail {
+
+                    /// @brief Get number of threads to use, zero meaning all the hardware threads.
+                    inline std::size_t threads_count_or_default(std::size_t threads_count) {
+                        if (threads_count == 0) {
+                            threads_count = std::thread::hardware_concurrency();
+                        }
+                        return std::max<std::size_t>(threads_count, 1);
+                    }
+
+                    /// @brief Split [0, count) into contiguous ranges and process them concurrently.
+                    /// @details Range boundaries are multiples of block_size, so callers processing
+                    ///     blocks of elements never share a block between threads. The calling thread
+                    ///     processes the first range itself.
+                    /// @param[in] count Number of elements.
+                    /// @param[in] block_size Granularity of the split.
+                    /// @param[in] threads_count Maximal number of threads to use, zero means all the
+                    ///     hardware threads.
+                    /// @param[in] func Callable invoked as func(begin, end), must not throw.
+                    template<typename TFunc>
+                    void parallel_for(std::size_t count, std::size_t block_size, std::size_t threads_count,
+                                      TFunc func) {
+                        std::size_t blocks_count = count / block_size + ((count % block_size) ? 1 : 0);
+                        threads_count = std::min(threads_count_or_default(threads_count), blocks_count);
+
+                        if (threads_count <= 1) {
+                            if (count > 0) {
+                                func(std::size_t(0), count);
+                            }
+                            return;
+                        }
+
+                        std::size_t blocks_per_thread = blocks_count / threads_count;
+                        std::size_t blocks_remainder = blocks_count % threads_count;
+
+                        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+                        std::size_t begin = 0;
+                        for (std::size_t i = 0; i < threads_count; ++i) {
+                            std::size_t blocks = blocks_per_thread + ((i < blocks_remainder) ? 1 : 0);
+                            std::size_t end = std::min(count, begin + blocks * block_size);
+                            ranges.emplace_back(begin, end);
+                            begin = end;
+                        }
+
+                        std::vector<std::thread> workers;
+                        workers.reserve(threads_count - 1);
+                        for (std::size_t i = 1; i < threads_count; ++i) {
+                            workers.emplace_back(func, ranges[i].first, ranges[i].second);
+                        }
+                        func(ranges[0].first, ranges[0].second);
+
+                        for (std::thread &worker : workers) {
+                            worker.join();
+                        }
+                    }
+                }    // namespace detail
+            }        // namespace processing
+        }            // namespace marshalling
+    }                // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_DETAIL_PARALLEL_HPP
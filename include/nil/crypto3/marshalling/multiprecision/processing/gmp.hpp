@@ -0,0 +1,126 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_GMP_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_GMP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <boost/multiprecision/gmp.hpp>
+
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/contiguous.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+                namespace detail {
+                    template<typename Endianness>
+                    constexpr int gmp_words_order() {
+                        return std::is_same<Endianness, nil::marshalling::endian::big_endian>::value ? 1 : -1;
+                    }
+                }    // namespace detail
+
+                /// @brief Write GMP integer into the output area using the native word-wise export.
+                /// @details Produces the same units as the generic variable length encoding, i.e. the
+                ///     minimal number of units, zero being written as a single unit.
+                /// @param[in] value Integer to be written.
+                /// @param[in] iter Output iterator.
+                /// @return Number of written units.
+                template<typename Endianness, typename TIter>
+                std::size_t write_gmp_data(mpz_srcptr value, TIter iter) {
+                    using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                    if constexpr (std::is_same<unit_type, bool>::value) {
+                        std::size_t bits_count = mpz_sizeinbase(value, 2);
+                        for (std::size_t i = 0; i < bits_count; ++i, ++iter) {
+                            std::size_t index = std::is_same<Endianness, nil::marshalling::endian::big_endian>::value ?
+                                                    bits_count - 1 - i :
+                                                    i;
+                            *iter = mpz_tstbit(value, index) != 0;
+                        }
+                        return bits_count;
+                    } else {
+                        static_assert(sizeof(unit_type) == 1, "only bit and byte units are supported");
+
+                        std::size_t count = 0;
+                        if (mpz_sgn(value) == 0) {
+                            *iter = 0;
+                            return 1;
+                        }
+
+                        if constexpr (detail::is_contiguous_byte_iterator<TIter>::value) {
+                            mpz_export(&*iter, &count, detail::gmp_words_order<Endianness>(), 1, 1, 0, value);
+                        } else {
+                            std::vector<unsigned char> buffer(mpz_sizeinbase(value, 256));
+                            mpz_export(buffer.data(), &count, detail::gmp_words_order<Endianness>(), 1, 1, 0, value);
+                            std::copy(buffer.begin(), buffer.begin() + count, iter);
+                        }
+                        return count;
+                    }
+                }
+
+                /// @brief Read GMP integer from the input area using the native word-wise import.
+                /// @param[out] value Integer to be read.
+                /// @param[in] iter Input iterator.
+                /// @param[in] value_size Number of units to read.
+                template<typename Endianness, typename TIter>
+                void read_gmp_data(mpz_ptr value, TIter iter, std::size_t value_size) {
+                    using unit_type = typename std::iterator_traits<TIter>::value_type;
+
+                    if constexpr (std::is_same<unit_type, bool>::value) {
+                        mpz_set_ui(value, 0);
+                        for (std::size_t i = 0; i < value_size; ++i, ++iter) {
+                            if (*iter) {
+                                mpz_setbit(value, std::is_same<Endianness, nil::marshalling::endian::big_endian>::value ?
+                                                      value_size - 1 - i :
+                                                      i);
+                            }
+                        }
+                    } else {
+                        static_assert(sizeof(unit_type) == 1, "only bit and byte units are supported");
+
+                        if (value_size == 0) {
+                            mpz_set_ui(value, 0);
+                        } else if constexpr (detail::is_contiguous_byte_iterator<TIter>::value) {
+                            mpz_import(value, value_size, detail::gmp_words_order<Endianness>(), 1, 1, 0, &*iter);
+                        } else {
+                            std::vector<unsigned char> buffer(iter, iter + value_size);
+                            mpz_import(value, value_size, detail::gmp_words_order<Endianness>(), 1, 1, 0,
+                                       buffer.data());
+                        }
+                    }
+                }
+            }    // namespace processing
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_GMP_HPP
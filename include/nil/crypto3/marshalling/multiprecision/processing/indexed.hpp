@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_INDEXED_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_INDEXED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include <nil/marshalling/endianness.hpp>
+#include <nil/marshalling/status_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/parallel.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+
+                /// @brief Word the values count is stored in.
+                using indexed_count_type = std::uint64_t;
+
+                /// @brief Word every value length is stored in.
+                using indexed_length_type = std::uint32_t;
+
+                /// @brief Number of bytes the values take in the indexed layout.
+                template<typename TInputIter>
+                std::size_t indexed_length(TInputIter first, TInputIter last) {
+                    std::size_t result = sizeof(indexed_count_type);
+                    for (; first != last; ++first) {
+                        result += sizeof(indexed_length_type) + length(*first);
+                    }
+                    return result;
+                }
+
+                /// @brief Write variable length values preceded by the table of their lengths.
+                /// @details The layout is the values count, the length in bytes of every value and
+                ///     then the minimal length encodings of the values, same as written by the non
+                ///     fixed precision integral. The count and lengths are written in the given
+                ///     endianness. The table lets the reader locate every value up front and decode
+                ///     them concurrently.
+                /// @param[in] first Beginning of the values range.
+                /// @param[in] last End of the values range.
+                /// @param[in, out] iter Output iterator.
+                /// @pre The iterator must be valid and can be successfully dereferenced
+                ///      and incremented at least indexed_length(first, last) times.
+                /// @post The iterator is advanced.
+                template<typename Endianness, typename TInputIter, typename TIter>
+                void write_indexed(TInputIter first, TInputIter last, TIter &iter) {
+                    detail::write_word<Endianness>(static_cast<indexed_count_type>(std::distance(first, last)), iter);
+                    for (TInputIter value_iter = first; value_iter != last; ++value_iter) {
+                        detail::write_word<Endianness>(static_cast<indexed_length_type>(length(*value_iter)), iter);
+                    }
+                    for (; first != last; ++first) {
+                        write_data<Endianness>(*first, iter);
+                        std::advance(iter, length(*first));
+                    }
+                }
+
+                /// @brief Read values written by write_indexed().
+                /// @details First the lengths table is read and turned into the value offsets, then
+                ///     the values are decoded in parallel, each thread taking a contiguous range.
+                /// @param[in, out] iter Random access input iterator.
+                /// @param[in] size Number of bytes available for reading.
+                /// @param[out] values Decoded values, resized to the stored count.
+                /// @param[in] threads_count Maximal number of threads to use, zero means all the
+                ///     hardware threads.
+                /// @return not_enough_data if the buffer is shorter than the lengths table claims,
+                ///     success otherwise.
+                /// @post The iterator is advanced past the last value.
+                template<typename Endianness, typename T, typename TIter>
+                nil::marshalling::status_type read_indexed(TIter &iter, std::size_t size, std::vector<T> &values,
+                                                           std::size_t threads_count = 0) {
+                    constexpr std::size_t block_size = 64;
+
+                    if (size < sizeof(indexed_count_type)) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+                    indexed_count_type count = detail::read_word<Endianness, indexed_count_type>(iter);
+                    size -= sizeof(indexed_count_type);
+
+                    if (count > size / sizeof(indexed_length_type)) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+                    size -= static_cast<std::size_t>(count) * sizeof(indexed_length_type);
+
+                    std::vector<std::size_t> offsets(static_cast<std::size_t>(count) + 1, 0);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        offsets[i + 1] = offsets[i] + detail::read_word<Endianness, indexed_length_type>(iter);
+                    }
+                    if (offsets.back() > size) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+
+                    values.resize(static_cast<std::size_t>(count));
+                    TIter payload = iter;
+                    detail::parallel_for(values.size(), block_size, threads_count,
+                                         [&](std::size_t begin, std::size_t end) {
+                                             for (std::size_t i = begin; i < end; ++i) {
+                                                 TIter value_iter =
+                                                     payload + static_cast<std::ptrdiff_t>(offsets[i]);
+                                                 values[i] = read_data<T, Endianness>(
+                                                     value_iter, (offsets[i + 1] - offsets[i]) * 8);
+                                             }
+                                         });
+
+                    iter += static_cast<std::ptrdiff_t>(offsets.back());
+                    return nil::marshalling::status_type::success;
+                }
+            }    // namespace processing
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_INDEXED_HPP
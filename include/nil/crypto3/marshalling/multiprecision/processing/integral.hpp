@@ -35,11 +35,30 @@
 
 #include <nil/marshalling/endianness.hpp>
 
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace marshalling {
             namespace processing {
 
+                /// @brief Get number of bits the variable length encoding of the value takes.
+                /// @details Zero value is still written as a single unit. The most significant bit
+                ///     lookup only inspects the top limb, so the complexity doesn't depend on the value.
+                /// @param[in] value Integral type value.
+                template<typename T>
+                std::size_t bit_length(const T &value) {
+                    return value == 0 ? 1 : boost::multiprecision::msb(value) + 1;
+                }
+
+                /// @brief Get number of bytes the variable length encoding of the value takes.
+                /// @param[in] value Integral type value.
+                template<typename T>
+                std::size_t length(const T &value) {
+                    std::size_t bits_count = bit_length(value);
+                    return bits_count / 8 + ((bits_count % 8) ? 1 : 0);
+                }
+
                 /// @brief Write part of integral value into the output area using big
                 ///     endian notation.
                 /// @tparam TSize Number of bytes to write.
@@ -69,21 +88,25 @@ namespace nil {
                 /// @post The iterator is advanced.
                 template<std::size_t TSize, typename T, typename TIter>
                 void write_big_endian(T value, TIter &iter) {
-                    std::size_t units_bits = std::is_same_v<typename std::iterator_traits<TIter>::value_type, bool> ? 
-                                        1 : sizeof(typename std::iterator_traits<TIter>::value_type) * 8;
-                    std::size_t chunk_bits = sizeof(typename std::iterator_traits<TIter>::value_type) * units_bits;
-                    std::size_t chunks_count = (TSize / chunk_bits) + ((TSize % chunk_bits) ? 1 : 0);
+                    if constexpr (detail::is_limb_kernel_applicable<T, TIter>::value) {
+                        detail::write_limbs_big_endian<TSize>(value, iter);
+                    } else {
+                        std::size_t units_bits = std::is_same_v<typename std::iterator_traits<TIter>::value_type, bool> ? 
+                                            1 : sizeof(typename std::iterator_traits<TIter>::value_type) * 8;
+                        std::size_t chunk_bits = sizeof(typename std::iterator_traits<TIter>::value_type) * units_bits;
+                        std::size_t chunks_count = (TSize / chunk_bits) + ((TSize % chunk_bits) ? 1 : 0);
 
-                    if (value > 0) {
-                        std::size_t begin_index =
-                            chunks_count - ((boost::multiprecision::msb(value) + 1) / chunk_bits +
-                                            (((boost::multiprecision::msb(value) + 1) % chunk_bits) ? 1 : 0));
+                        if (value > 0) {
+                            std::size_t begin_index =
+                                chunks_count - ((boost::multiprecision::msb(value) + 1) / chunk_bits +
+                                                (((boost::multiprecision::msb(value) + 1) % chunk_bits) ? 1 : 0));
 
-                        std::fill(iter, iter + begin_index, 0);
+                            std::fill(iter, iter + begin_index, 0);
 
-                        export_bits(value, iter + begin_index, chunk_bits, true);
-                    } else {
-                        std::fill(iter, iter + chunks_count, 0);
+                            export_bits(value, iter + begin_index, chunk_bits, true);
+                        } else {
+                            std::fill(iter, iter + chunks_count, 0);
+                        }
                     }
                 }
 
@@ -156,22 +179,26 @@ namespace nil {
                 /// @post The iterator is advanced.
                 template<std::size_t TSize, typename T, typename TIter>
                 void write_little_endian(T value, TIter &iter) {
-                    std::size_t units_bits = std::is_same_v<typename std::iterator_traits<TIter>::value_type, bool> ? 
-                                        1 : sizeof(typename std::iterator_traits<TIter>::value_type) * 8;
-                    std::size_t chunk_bits = sizeof(typename std::iterator_traits<TIter>::value_type) * units_bits;
-                    std::size_t chunks_count = (TSize / chunk_bits) + ((TSize % chunk_bits) ? 1 : 0);
-
-                    if (value > 0) {
-                        std::size_t begin_index = ((boost::multiprecision::msb(value) + 1) / chunk_bits +
-                                            (((boost::multiprecision::msb(value) + 1) % chunk_bits) ? 1 : 0));
-
-                        if (begin_index < chunks_count) {
-                            std::fill(iter + begin_index, iter + chunks_count, 0x00);
-                        }
-
-                        export_bits(value, iter, chunk_bits, false);
+                    if constexpr (detail::is_limb_kernel_applicable<T, TIter>::value) {
+                        detail::write_limbs_little_endian<TSize>(value, iter);
                     } else {
-                        std::fill(iter, iter + chunks_count, 0);
+                        std::size_t units_bits = std::is_same_v<typename std::iterator_traits<TIter>::value_type, bool> ? 
+                                            1 : sizeof(typename std::iterator_traits<TIter>::value_type) * 8;
+                        std::size_t chunk_bits = sizeof(typename std::iterator_traits<TIter>::value_type) * units_bits;
+                        std::size_t chunks_count = (TSize / chunk_bits) + ((TSize % chunk_bits) ? 1 : 0);
+
+                        if (value > 0) {
+                            std::size_t begin_index = ((boost::multiprecision::msb(value) + 1) / chunk_bits +
+                                                (((boost::multiprecision::msb(value) + 1) % chunk_bits) ? 1 : 0));
+
+                            if (begin_index < chunks_count) {
+                                std::fill(iter + begin_index, iter + chunks_count, 0x00);
+                            }
+
+                            export_bits(value, iter, chunk_bits, false);
+                        } else {
+                            std::fill(iter, iter + chunks_count, 0);
+                        }
                     }
                 }
 
@@ -0,0 +1,136 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_INTERLEAVED_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_INTERLEAVED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include <nil/marshalling/endianness.hpp>
+#include <nil/marshalling/status_type.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+
+                /// @brief Word the limb interleaved layout is made of.
+                /// @details Fixed to 64 bits regardless of the platform limb width, so the layout is
+                ///     portable.
+                using interleaved_word_type = std::uint64_t;
+
+                /// @brief Number of words a single value of type T takes in the limb interleaved layout.
+                template<typename T>
+                constexpr std::size_t interleaved_words_count() {
+                    static_assert(detail::limb_traits<T>::is_specialized,
+                                  "limb interleaved layout requires direct limb access");
+
+                    constexpr std::size_t word_bits = std::numeric_limits<interleaved_word_type>::digits;
+                    return detail::limb_traits<T>::bits / word_bits +
+                           ((detail::limb_traits<T>::bits % word_bits) ? 1 : 0);
+                }
+
+                /// @brief Number of bytes count values of type T take in the limb interleaved layout.
+                template<typename T>
+                constexpr std::size_t interleaved_length(std::size_t count) {
+                    return count * interleaved_words_count<T>() * sizeof(interleaved_word_type);
+                }
+
+                /// @brief Write values using the limb interleaved (structure of arrays) layout.
+                /// @details Word 0 of every value is written first, then word 1 of every value and so
+                ///     on, each word being sizeof(interleaved_word_type) bytes in the given endianness.
+                ///     With little endian words the output can be loaded into vector registers
+                ///     across the values directly.
+                /// @param[in] first Beginning of the values range.
+                /// @param[in] last End of the values range.
+                /// @param[in, out] iter Output iterator.
+                /// @pre The iterator must be valid and can be successfully dereferenced
+                ///      and incremented at least interleaved_length<T>(count) times.
+                /// @post The iterator is advanced.
+                template<typename Endianness, typename TInputIter, typename TIter>
+                void write_interleaved(TInputIter first, TInputIter last, TIter &iter) {
+                    using value_type = typename std::iterator_traits<TInputIter>::value_type;
+                    using traits = detail::limb_traits<value_type>;
+
+                    constexpr std::size_t words_count = interleaved_words_count<value_type>();
+
+                    for (std::size_t word_index = 0; word_index < words_count; ++word_index) {
+                        for (TInputIter value_iter = first; value_iter != last; ++value_iter) {
+                            detail::write_word<Endianness>(
+                                detail::extract_word<interleaved_word_type, traits::limb_count>(
+                                    traits::limbs(*value_iter), word_index),
+                                iter);
+                        }
+                    }
+                }
+
+                /// @brief Read values stored using the limb interleaved (structure of arrays) layout.
+                /// @details The number of values to read is defined by the output range.
+                /// @param[in, out] iter Input iterator.
+                /// @param[in] size Number of bytes available for reading.
+                /// @param[in] first Beginning of the output values range.
+                /// @param[in] last End of the output values range.
+                /// @return Status of read operation.
+                /// @post The iterator is advanced.
+                template<typename Endianness, typename TIter, typename TOutputIter>
+                nil::marshalling::status_type read_interleaved(TIter &iter, std::size_t size, TOutputIter first,
+                                                               TOutputIter last) {
+                    using value_type = typename std::iterator_traits<TOutputIter>::value_type;
+                    using traits = detail::limb_traits<value_type>;
+
+                    constexpr std::size_t words_count = interleaved_words_count<value_type>();
+
+                    std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+                    if (size < interleaved_length<value_type>(count)) {
+                        return nil::marshalling::status_type::not_enough_data;
+                    }
+
+                    for (TOutputIter value_iter = first; value_iter != last; ++value_iter) {
+                        traits::clear(*value_iter);
+                    }
+
+                    for (std::size_t word_index = 0; word_index < words_count; ++word_index) {
+                        for (TOutputIter value_iter = first; value_iter != last; ++value_iter) {
+                            detail::insert_word<interleaved_word_type, traits::limb_count>(
+                                traits::limbs(*value_iter), word_index,
+                                detail::read_word<Endianness, interleaved_word_type>(iter));
+                        }
+                    }
+
+                    for (TOutputIter value_iter = first; value_iter != last; ++value_iter) {
+                        traits::normalize(*value_iter);
+                    }
+                    return nil::marshalling::status_type::success;
+                }
+            }    // namespace processing
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_INTERLEAVED_HPP
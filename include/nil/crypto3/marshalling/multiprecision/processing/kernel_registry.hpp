@@ -0,0 +1,388 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_KERNEL_REGISTRY_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_KERNEL_REGISTRY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/non_temporal.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+
+                /// @brief Instruction set extensions the kernels may depend on.
+                struct cpu_features {
+                    bool sse2 = false;
+                    bool ssse3 = false;
+                    bool avx2 = false;
+                    bool bmi2 = false;
+                };
+
+                /// @brief Get the instruction set extensions of the running CPU, detected once.
+                inline const cpu_features &detected_cpu_features() {
+                    static const cpu_features features = []() {
+                        cpu_features result;
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+                        __builtin_cpu_init();
+                        result.sse2 = __builtin_cpu_supports("sse2");
+                        result.ssse3 = __builtin_cpu_supports("ssse3");
+                        result.avx2 = __builtin_cpu_supports("avx2");
+                        result.bmi2 = __builtin_cpu_supports("bmi2");
+#endif
+                        return result;
+                    }();
+                    return features;
+                }
+
+                namespace detail {
+                    template<typename T>
+                    struct kernel_value_length
+                        : std::integral_constant<std::size_t, std::numeric_limits<T>::digits / 8 +
+                                                                  ((std::numeric_limits<T>::digits % 8) ? 1 : 0)> { };
+
+                    template<typename Endianness, typename T>
+                    std::uint8_t *write_generic_kernel(const T *first, const T *last, std::uint8_t *out) {
+                        constexpr std::size_t value_length = kernel_value_length<T>::value;
+
+                        for (; first != last; ++first, out += value_length) {
+                            std::size_t bytes_count = length(*first);
+                            if constexpr (std::is_same<Endianness, nil::marshalling::endian::big_endian>::value) {
+                                std::fill(out, out + value_length - bytes_count, 0);
+                                boost::multiprecision::export_bits(*first, out + value_length - bytes_count, 8, true);
+                            } else {
+                                boost::multiprecision::export_bits(*first, out, 8, false);
+                                std::fill(out + bytes_count, out + value_length, 0);
+                            }
+                        }
+                        return out;
+                    }
+
+                    template<typename Endianness, typename T>
+                    std::uint8_t *write_limb_kernel(const T *first, const T *last, std::uint8_t *out) {
+                        for (; first != last; ++first) {
+                            out = write_limbs<Endianness>(*first, out);
+                        }
+                        return out;
+                    }
+
+                    /// @details Short runs fall back to regular stores, see default_non_temporal_threshold,
+                    ///     so that binding this kernel doesn't stream and fence every small write.
+                    template<typename Endianness, typename T>
+                    std::uint8_t *write_non_temporal_kernel(const T *first, const T *last, std::uint8_t *out) {
+                        return write_non_temporal<Endianness>(first, last, out);
+                    }
+
+                    template<typename Endianness, typename T>
+                    const std::uint8_t *read_generic_kernel(const std::uint8_t *in, T *first, T *last) {
+                        constexpr std::size_t value_length = kernel_value_length<T>::value;
+
+                        for (; first != last; ++first, in += value_length) {
+                            boost::multiprecision::import_bits(
+                                *first, in, in + value_length, 8,
+                                std::is_same<Endianness, nil::marshalling::endian::big_endian>::value);
+                        }
+                        return in;
+                    }
+
+                    template<typename Endianness, typename T>
+                    const std::uint8_t *read_limb_kernel(const std::uint8_t *in, T *first, T *last) {
+                        for (; first != last; ++first) {
+                            in = read_limbs<Endianness>(*first, in);
+                        }
+                        return in;
+                    }
+
+                    inline bool always_supported(const cpu_features &) {
+                        return true;
+                    }
+
+                    inline bool sse2_supported(const cpu_features &features) {
+                        return features.sse2;
+                    }
+
+                    /// @brief Kernels bookkeeping shared by the write and the read registries.
+                    template<typename TKernel>
+                    class kernel_registry {
+                    public:
+                        using kernel_type = TKernel;
+
+                        struct kernel_info {
+                            const char *name;
+                            bool (*supported)(const cpu_features &);
+                            kernel_type kernel;
+                        };
+
+                        /// @brief Get the bound kernel.
+                        kernel_type kernel() const {
+                            return active_.load(std::memory_order_acquire);
+                        }
+
+                        /// @brief Get the name of the bound kernel.
+                        const char *kernel_name() const {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            for (const kernel_info &info : kernels_) {
+                                if (info.kernel == kernel()) {
+                                    return info.name;
+                                }
+                            }
+                            return "";
+                        }
+
+                        /// @brief Get the kernels supported by the running CPU.
+                        std::vector<kernel_info> supported_kernels() const {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            std::vector<kernel_info> result;
+                            std::copy_if(
+                                kernels_.begin(), kernels_.end(), std::back_inserter(result),
+                                [](const kernel_info &info) { return info.supported(detected_cpu_features()); });
+                            return result;
+                        }
+
+                        /// @brief Register additional kernel, it is not bound until pinned or calibrated.
+                        void add(const kernel_info &info) {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            kernels_.push_back(info);
+                        }
+
+                        /// @brief Bind the kernel with the given name.
+                        /// @return false if there is no such kernel or it is not supported by the
+                        ///     running CPU, the binding is not changed then.
+                        bool pin(std::string_view name) {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            for (const kernel_info &info : kernels_) {
+                                if (name == info.name && info.supported(detected_cpu_features())) {
+                                    active_.store(info.kernel, std::memory_order_release);
+                                    return true;
+                                }
+                            }
+                            return false;
+                        }
+
+                    protected:
+                        kernel_registry() = default;
+
+                        /// @brief Bind the last registered kernel, which is the preferred one, then
+                        ///     apply the environment variables.
+                        template<typename TCalibrate>
+                        void bind_default(const char *kernel_variable, TCalibrate calibrate) {
+                            active_.store(kernels_.back().kernel, std::memory_order_relaxed);
+
+                            if (const char *name = std::getenv(kernel_variable)) {
+                                pin(name);
+                            } else if (const char *calibrate_flag = std::getenv("CRYPTO3_MARSHALLING_CALIBRATE")) {
+                                if (std::string_view(calibrate_flag) == "1") {
+                                    calibrate();
+                                }
+                            }
+                        }
+
+                        /// @brief Bind the supported kernel for which run(kernel) takes the least time.
+                        template<typename TRun>
+                        void bind_fastest(std::size_t rounds, TRun run) {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            kernel_type best = active_.load(std::memory_order_relaxed);
+                            auto best_time = std::chrono::steady_clock::duration::max();
+                            for (const kernel_info &info : kernels_) {
+                                if (!info.supported(detected_cpu_features())) {
+                                    continue;
+                                }
+                                auto time = std::chrono::steady_clock::duration::max();
+                                for (std::size_t round = 0; round < rounds; ++round) {
+                                    auto begin = std::chrono::steady_clock::now();
+                                    run(info.kernel);
+                                    time = std::min(time, std::chrono::steady_clock::now() - begin);
+                                }
+                                if (time < best_time) {
+                                    best = info.kernel;
+                                    best_time = time;
+                                }
+                            }
+                            active_.store(best, std::memory_order_release);
+                        }
+
+                        template<typename T>
+                        static std::vector<T> calibration_values(std::size_t sample_count) {
+                            std::vector<T> values(sample_count);
+                            for (std::size_t i = 0; i < values.size(); ++i) {
+                                values[i] = ~T(0) - T(i * 0x9E3779B9u);
+                            }
+                            return values;
+                        }
+
+                        mutable std::mutex mutex_;
+                        std::vector<kernel_info> kernels_;
+                        std::atomic<kernel_type> active_;
+                    };
+                }    // namespace detail
+
+                /// @brief Registry of the kernels writing fixed precision values of type T back to
+                ///     back into bytes in the given endianness.
+                /// @details Every kernel produces the same bytes, they differ in speed only. On first
+                ///     use the registry binds the preferred kernel supported by the running CPU. The
+                ///     binding can be changed with pin() or calibrate(), or at startup with the
+                ///     environment variables:
+                ///     - CRYPTO3_MARSHALLING_WRITE_KERNEL=<name> pins the kernel by name;
+                ///     - CRYPTO3_MARSHALLING_CALIBRATE=1 times every supported kernel and binds the
+                ///       fastest one.
+                ///     The bound kernel is read without locking and is called once per contiguous run
+                ///     of values: the vector paths of serialization_context, serialization_service
+                ///     and load_file write through it, see is_kernel_dispatched. Single
+                ///     types::integral fields keep the inline limb conversion. Kernels added with
+                ///     add() must produce the same bytes as the integral field.
+                template<typename T, typename Endianness>
+                class write_kernel_registry
+                    : public detail::kernel_registry<std::uint8_t *(*)(const T *, const T *, std::uint8_t *)> {
+                    static_assert(std::numeric_limits<T>::is_bounded, "kernels write fixed precision values");
+
+                    using base_type = detail::kernel_registry<std::uint8_t *(*)(const T *, const T *, std::uint8_t *)>;
+
+                public:
+                    using typename base_type::kernel_info;
+                    using typename base_type::kernel_type;
+
+                    static write_kernel_registry &instance() {
+                        static write_kernel_registry registry;
+                        return registry;
+                    }
+
+                    /// @brief Write values using the bound kernel.
+                    /// @return Pointer past the last written byte.
+                    std::uint8_t *write(const T *first, const T *last, std::uint8_t *out) const {
+                        return this->kernel()(first, last, out);
+                    }
+
+                    /// @brief Time every supported kernel on sample_count values and bind the
+                    ///     fastest one.
+                    /// @details Measures single thread throughput only, kernels which pay off under
+                    ///     concurrent load (e.g. non-temporal stores) may need to be pinned instead.
+                    void calibrate(std::size_t sample_count = 1024, std::size_t rounds = 8) {
+                        std::vector<T> values = base_type::template calibration_values<T>(sample_count);
+                        std::vector<std::uint8_t> output(values.size() * detail::kernel_value_length<T>::value + 64);
+
+                        this->bind_fastest(rounds, [&](kernel_type kernel) {
+                            kernel(values.data(), values.data() + values.size(), output.data());
+                        });
+                    }
+
+                private:
+                    write_kernel_registry() {
+                        this->kernels_.push_back(
+                            {"generic", &detail::always_supported, &detail::write_generic_kernel<Endianness, T>});
+                        if constexpr (detail::limb_traits<T>::is_specialized) {
+                            this->kernels_.push_back({"non_temporal", &detail::sse2_supported,
+                                                      &detail::write_non_temporal_kernel<Endianness, T>});
+                            this->kernels_.push_back(
+                                {"limb", &detail::always_supported, &detail::write_limb_kernel<Endianness, T>});
+                        }
+                        this->bind_default("CRYPTO3_MARSHALLING_WRITE_KERNEL", [this]() { calibrate(); });
+                    }
+                };
+
+                /// @brief Registry of the kernels reading fixed precision values of type T written
+                ///     back to back in the given endianness.
+                /// @details Same as write_kernel_registry, CRYPTO3_MARSHALLING_READ_KERNEL=<name> pins
+                ///     the kernel by name.
+                template<typename T, typename Endianness>
+                class read_kernel_registry
+                    : public detail::kernel_registry<const std::uint8_t *(*)(const std::uint8_t *, T *, T *)> {
+                    static_assert(std::numeric_limits<T>::is_bounded, "kernels read fixed precision values");
+
+                    using base_type =
+                        detail::kernel_registry<const std::uint8_t *(*)(const std::uint8_t *, T *, T *)>;
+
+                public:
+                    using typename base_type::kernel_info;
+                    using typename base_type::kernel_type;
+
+                    static read_kernel_registry &instance() {
+                        static read_kernel_registry registry;
+                        return registry;
+                    }
+
+                    /// @brief Read values using the bound kernel.
+                    /// @return Pointer past the last read byte.
+                    const std::uint8_t *read(const std::uint8_t *in, T *first, T *last) const {
+                        return this->kernel()(in, first, last);
+                    }
+
+                    /// @brief Time every supported kernel on sample_count values and bind the
+                    ///     fastest one.
+                    void calibrate(std::size_t sample_count = 1024, std::size_t rounds = 8) {
+                        std::vector<T> values = base_type::template calibration_values<T>(sample_count);
+                        std::vector<std::uint8_t> input(values.size() * detail::kernel_value_length<T>::value);
+                        detail::write_generic_kernel<Endianness>(values.data(), values.data() + values.size(),
+                                                                 input.data());
+
+                        this->bind_fastest(rounds, [&](kernel_type kernel) {
+                            kernel(input.data(), values.data(), values.data() + values.size());
+                        });
+                    }
+
+                private:
+                    read_kernel_registry() {
+                        this->kernels_.push_back(
+                            {"generic", &detail::always_supported, &detail::read_generic_kernel<Endianness, T>});
+                        if constexpr (detail::limb_traits<T>::is_specialized) {
+                            this->kernels_.push_back(
+                                {"limb", &detail::always_supported, &detail::read_limb_kernel<Endianness, T>});
+                        }
+                        this->bind_default("CRYPTO3_MARSHALLING_READ_KERNEL", [this]() { calibrate(); });
+                    }
+                };
+
+                /// @brief Checks whether contiguous runs of T are read and written through TIter
+                ///     with the kernels bound in the registries.
+                /// @details That is the case for the types with direct limb access and contiguous
+                ///     byte storage, other combinations go value by value.
+                template<typename T, typename TIter>
+                struct is_kernel_dispatched
+                    : std::conjunction<std::bool_constant<detail::limb_traits<T>::is_specialized>,
+                                       std::is_integral<typename std::iterator_traits<TIter>::value_type>,
+                                       detail::is_contiguous_byte_iterator<TIter>> { };
+            }    // namespace processing
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_KERNEL_REGISTRY_HPP
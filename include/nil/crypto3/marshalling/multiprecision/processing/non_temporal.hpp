@@ -0,0 +1,177 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_NON_TEMPORAL_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_NON_TEMPORAL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CRYPTO3_MARSHALLING_HAS_NON_TEMPORAL_STORES
+#endif
+
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+
+                /// @brief Output size in bytes from which write_non_temporal() bypasses the caches
+                ///     by default.
+                /// @details Below it the output most likely fits the caches and is cheaper to write
+                ///     the regular way.
+                constexpr std::size_t default_non_temporal_threshold = std::size_t(1) << 20;
+
+                namespace detail {
+                    /// @brief Collects output bytes into cache lines and writes every complete
+                    ///     destination cache line with non-temporal stores.
+                    /// @details Bytes before the first line boundary of the output and after the
+                    ///     last one are written the regular way.
+                    class non_temporal_writer {
+                    public:
+                        static constexpr std::size_t line_size = 64;
+
+                        explicit non_temporal_writer(std::uint8_t *out) :
+                            out_(out), head_((line_size - reinterpret_cast<std::uintptr_t>(out) % line_size) %
+                                             line_size) {
+                        }
+
+                        void put(const std::uint8_t *data, std::size_t size) {
+                            if (head_) {
+                                std::size_t chunk = std::min(head_, size);
+                                out_ = std::copy_n(data, chunk, out_);
+                                head_ -= chunk;
+                                data += chunk;
+                                size -= chunk;
+                            }
+
+                            while (size) {
+                                std::size_t chunk = std::min(line_size - fill_, size);
+                                std::memcpy(line_.data() + fill_, data, chunk);
+                                fill_ += chunk;
+                                data += chunk;
+                                size -= chunk;
+
+                                if (fill_ == line_size) {
+                                    store_line();
+                                }
+                            }
+                        }
+
+                        /// @brief Write the incomplete last line and order the non-temporal stores
+                        ///     before any store following this call.
+                        /// @return Pointer past the last written byte.
+                        std::uint8_t *finish() {
+                            out_ = std::copy_n(line_.data(), fill_, out_);
+                            fill_ = 0;
+#if defined(CRYPTO3_MARSHALLING_HAS_NON_TEMPORAL_STORES)
+                            _mm_sfence();
+#endif
+                            return out_;
+                        }
+
+                    private:
+                        void store_line() {
+#if defined(CRYPTO3_MARSHALLING_HAS_NON_TEMPORAL_STORES)
+                            for (std::size_t i = 0; i < line_size; i += sizeof(__m128i)) {
+                                _mm_stream_si128(reinterpret_cast<__m128i *>(out_ + i),
+                                                 _mm_load_si128(reinterpret_cast<const __m128i *>(line_.data() + i)));
+                            }
+#else
+                            std::memcpy(out_, line_.data(), line_size);
+#endif
+                            out_ += line_size;
+                            fill_ = 0;
+                        }
+
+                        std::uint8_t *out_;
+                        std::size_t head_;
+                        alignas(line_size) std::array<std::uint8_t, line_size> line_;
+                        std::size_t fill_ = 0;
+                    };
+
+                    template<typename Endianness, typename T, typename TIter>
+                    TIter write_limbs(const T &value, TIter iter) {
+                        if constexpr (std::is_same<Endianness, nil::marshalling::endian::big_endian>::value) {
+                            return write_limbs_big_endian<limb_traits<T>::bits>(value, iter);
+                        } else {
+                            return write_limbs_little_endian<limb_traits<T>::bits>(value, iter);
+                        }
+                    }
+                }    // namespace detail
+
+                /// @brief Write fixed precision values back to back bypassing the caches for large
+                ///     outputs.
+                /// @details Produces the same bytes as writing every value with the fixed precision
+                ///     integral. If the output is at least threshold bytes long, complete cache lines
+                ///     are written with non-temporal (streaming) stores followed by a store fence,
+                ///     so an output which is never read back does not evict the working set of the
+                ///     other threads. Falls back to the regular stores on targets without SSE2.
+                /// @param[in] first Beginning of the values range.
+                /// @param[in] last End of the values range.
+                /// @param[out] out Output area.
+                /// @param[in] threshold Output size from which the non-temporal stores are used.
+                /// @return Pointer past the last written byte.
+                template<typename Endianness, typename TInputIter>
+                std::uint8_t *write_non_temporal(TInputIter first, TInputIter last, std::uint8_t *out,
+                                                 std::size_t threshold = default_non_temporal_threshold) {
+                    using value_type = typename std::iterator_traits<TInputIter>::value_type;
+                    using traits = detail::limb_traits<value_type>;
+
+                    static_assert(traits::is_specialized, "non-temporal writer requires direct limb access");
+
+                    constexpr std::size_t value_length = traits::bits / 8 + ((traits::bits % 8) ? 1 : 0);
+
+                    std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+                    if (count * value_length < threshold) {
+                        for (; first != last; ++first) {
+                            out = detail::write_limbs<Endianness>(*first, out);
+                        }
+                        return out;
+                    }
+
+                    detail::non_temporal_writer writer(out);
+                    std::array<std::uint8_t, value_length> buffer;
+                    for (; first != last; ++first) {
+                        detail::write_limbs<Endianness>(*first, buffer.data());
+                        writer.put(buffer.data(), buffer.size());
+                    }
+                    return writer.finish();
+                }
+            }    // namespace processing
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_NON_TEMPORAL_HPP
@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_PROCESSING_WINDOWS_HPP
+#define CRYPTO3_MARSHALLING_PROCESSING_WINDOWS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/limbs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+                namespace detail {
+                    /// @brief Extracts Window bits starting from the given bit offset out of the limbs.
+                    /// @details Windows may straddle two limbs, bits past the last limb are read as zeroes.
+                    template<std::size_t Window, std::size_t LimbCount, typename TLimb>
+                    inline std::uint32_t extract_window(const TLimb *limbs, std::size_t offset) {
+                        constexpr std::size_t limb_bits = std::numeric_limits<TLimb>::digits;
+                        constexpr TLimb mask = static_cast<TLimb>((TLimb(1) << Window) - 1);
+
+                        std::size_t limb_index = offset / limb_bits;
+                        std::size_t shift = offset % limb_bits;
+
+                        TLimb window = limbs[limb_index] >> shift;
+                        if (shift + Window > limb_bits && limb_index + 1 < LimbCount) {
+                            window |= limbs[limb_index + 1] << (limb_bits - shift);
+                        }
+                        return static_cast<std::uint32_t>(window & mask);
+                    }
+                }    // namespace detail
+
+                /// @brief Number of Window bits wide digits a value of type T is split into.
+                template<std::size_t Window, typename T>
+                constexpr std::size_t windows_count() {
+                    static_assert(detail::limb_traits<T>::is_specialized, "windows export requires direct limb access");
+                    static_assert(Window >= 2 && Window <= 16, "window width must be within [2, 16]");
+
+                    return detail::limb_traits<T>::bits / Window + ((detail::limb_traits<T>::bits % Window) ? 1 : 0);
+                }
+
+                /// @brief Number of signed digits a value of type T is split into.
+                /// @details One more than windows_count() for the final carry.
+                template<std::size_t Window, typename T>
+                constexpr std::size_t signed_windows_count() {
+                    return windows_count<Window, T>() + 1;
+                }
+
+                /// @brief Split value into Window bits wide digits, least significant digit first.
+                /// @details value == sum(out[i] << (i * Window)). The digits are taken straight from the
+                ///     limbs, no intermediate byte encoding is produced.
+                /// @param[in] value Value to split.
+                /// @param[out] out Output digits, windows_count<Window, T>() of them.
+                /// @return Pointer past the last written digit.
+                template<std::size_t Window, typename T>
+                std::uint16_t *export_windows(const T &value, std::uint16_t *out) {
+                    using traits = detail::limb_traits<T>;
+
+                    constexpr std::size_t count = windows_count<Window, T>();
+
+                    const typename traits::limb_type *limbs = traits::limbs(value);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        *out++ = static_cast<std::uint16_t>(
+                            detail::extract_window<Window, traits::limb_count>(limbs, i * Window));
+                    }
+                    return out;
+                }
+
+                /// @brief Split value into signed digits within [-2^(Window - 1), 2^(Window - 1)),
+                ///     least significant digit first.
+                /// @details value == sum(out[i] * 2^(i * Window)). Every digit greater or equal to
+                ///     2^(Window - 1) is replaced by its negative counterpart and a carry into the next
+                ///     digit, which halves the precomputed table size in the windowed scalar
+                ///     multiplication.
+                /// @param[in] value Value to split.
+                /// @param[out] out Output digits, signed_windows_count<Window, T>() of them.
+                /// @return Pointer past the last written digit.
+                template<std::size_t Window, typename T>
+                std::int16_t *export_signed_windows(const T &value, std::int16_t *out) {
+                    using traits = detail::limb_traits<T>;
+
+                    constexpr std::size_t count = windows_count<Window, T>();
+                    constexpr std::int32_t half = std::int32_t(1) << (Window - 1);
+                    constexpr std::int32_t full = std::int32_t(1) << Window;
+
+                    const typename traits::limb_type *limbs = traits::limbs(value);
+                    std::int32_t carry = 0;
+                    for (std::size_t i = 0; i < count; ++i) {
+                        std::int32_t digit = static_cast<std::int32_t>(
+                                                 detail::extract_window<Window, traits::limb_count>(limbs, i * Window)) +
+                                             carry;
+                        carry = (digit >= half) ? 1 : 0;
+                        *out++ = static_cast<std::int16_t>(digit - carry * full);
+                    }
+                    *out++ = static_cast<std::int16_t>(carry);
+                    return out;
+                }
+
+                /// @brief Split every value of the range into Window bits wide digits.
+                /// @details Digits of every value take windows_count<Window, T>() consecutive
+                ///     outputs.
+                /// @return Pointer past the last written digit.
+                template<std::size_t Window, typename TInputIter>
+                std::uint16_t *export_windows(TInputIter first, TInputIter last, std::uint16_t *out) {
+                    for (; first != last; ++first) {
+                        out = export_windows<Window>(*first, out);
+                    }
+                    return out;
+                }
+
+                /// @brief Split every value of the range into signed digits.
+                /// @details Digits of every value take signed_windows_count<Window, T>() consecutive
+                ///     outputs.
+                /// @return Pointer past the last written digit.
+                template<std::size_t Window, typename TInputIter>
+                std::int16_t *export_signed_windows(TInputIter first, TInputIter last, std::int16_t *out) {
+                    for (; first != last; ++first) {
+                        out = export_signed_windows<Window>(*first, out);
+                    }
+                    return out;
+                }
+            }    // namespace processing
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_PROCESSING_WINDOWS_HPP
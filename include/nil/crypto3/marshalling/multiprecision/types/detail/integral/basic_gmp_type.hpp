@@ -0,0 +1,139 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_BASIC_INTEGRAL_GMP_HPP
+#define CRYPTO3_MARSHALLING_BASIC_INTEGRAL_GMP_HPP
+
+#include <type_traits>
+
+#include <nil/marshalling/status_type.hpp>
+
+#include <boost/multiprecision/number.hpp>
+#include <boost/multiprecision/gmp.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/gmp.hpp>
+#include <nil/crypto3/marshalling/multiprecision/types/detail/integral/basic_type.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace types {
+                namespace detail {
+                    /// @brief Variable length integral backed by GMP.
+                    /// @details Same encoding as for the other non-fixed precision backends, but the
+                    ///     conversion is done by the native word-wise mpz_export()/mpz_import().
+                    template<typename TTypeBase, boost::multiprecision::expression_template_option ExpressionTemplates>
+                    class basic_integral<TTypeBase, boost::multiprecision::gmp_int, ExpressionTemplates, false>
+                        : public TTypeBase {
+                        using T = boost::multiprecision::number<boost::multiprecision::gmp_int, ExpressionTemplates>;
+
+                        using base_impl_type = TTypeBase;
+
+                    public:
+                        using value_type = T;
+                        using serialized_type = value_type;
+
+                        basic_integral() = default;
+
+                        explicit basic_integral(value_type val) : value_(val) {
+                        }
+
+                        basic_integral(const basic_integral &) = default;
+
+                        basic_integral(basic_integral &&) = default;
+
+                        ~basic_integral() noexcept = default;
+
+                        basic_integral &operator=(const basic_integral &) = default;
+
+                        basic_integral &operator=(basic_integral &&) = default;
+
+                        const value_type &value() const {
+                            return value_;
+                        }
+
+                        value_type &value() {
+                            return value_;
+                        }
+
+                        /// @brief Get number of bytes the current value is serialized into.
+                        std::size_t length() const {
+                            return mpz_sizeinbase(value_.backend().data(), 256);
+                        }
+
+                        static constexpr std::size_t min_length() {
+                            return 0;
+                        }
+
+                        /// @brief Get number of bits the current value is serialized into.
+                        std::size_t bit_length() const {
+                            return mpz_sizeinbase(value_.backend().data(), 2);
+                        }
+
+                        static constexpr serialized_type to_serialized(value_type val) {
+                            return static_cast<serialized_type>(val);
+                        }
+
+                        static constexpr value_type from_serialized(serialized_type val) {
+                            return val;
+                        }
+
+                        template<typename TIter>
+                        nil::marshalling::status_type read(TIter &iter, std::size_t size) {
+                            read_no_status(iter, size);
+                            iter += size;
+                            return nil::marshalling::status_type::success;
+                        }
+
+                    private:
+                        template<typename TIter>
+                        void read_no_status(TIter &iter, std::size_t size) {
+                            crypto3::marshalling::processing::read_gmp_data<typename base_impl_type::endian_type>(
+                                value_.backend().data(), iter, size);
+                        }
+
+                    public:
+                        template<typename TIter>
+                        nil::marshalling::status_type write(TIter &iter, std::size_t size) const {
+                            write_no_status(iter);
+                            iter += size;
+                            return nil::marshalling::status_type::success;
+                        }
+
+                        template<typename TIter>
+                        void write_no_status(TIter &iter) const {
+                            crypto3::marshalling::processing::write_gmp_data<typename base_impl_type::endian_type>(
+                                value_.backend().data(), iter);
+                        }
+
+                    private:
+                        value_type value_ = static_cast<value_type>(0);
+                    };
+                }    // namespace detail
+            }        // namespace types
+        }            // namespace marshalling
+    }                // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_BASIC_INTEGRAL_GMP_HPP
@@ -38,6 +38,14 @@
 #include <nil/crypto3/marshalling/multiprecision/processing/integral.hpp>
 #include <nil/crypto3/marshalling/multiprecision/types/detail/integral/basic_type.hpp>
 
+namespace boost {
+    namespace multiprecision {
+        namespace backends {
+            struct gmp_int;
+        }    // namespace backends
+    }        // namespace multiprecision
+}    // namespace boost
+
 namespace nil {
     namespace crypto3 {
         namespace marshalling {
@@ -51,7 +59,9 @@ namespace nil {
 
                         using base_impl_type = TTypeBase;
 
-                        std::size_t cur_length = 0;
+                        static_assert(!std::is_same<Backend, boost::multiprecision::backends::gmp_int>::value,
+                                      "GMP backed numbers need the specialization from types/integral_gmp.hpp");
+
                     public:
                         using value_type = T;
                         using serialized_type = value_type;
@@ -59,10 +69,6 @@ namespace nil {
                         basic_integral() = default;
 
                         explicit basic_integral(value_type val) : value_(val) {
-
-                            std::size_t bits_count = boost::multiprecision::msb(val) + 1;
-
-                            cur_length = bits_count / 8 + (bits_count%8?1:0);
                         }
 
                         basic_integral(const basic_integral &) = default;
@@ -83,16 +89,20 @@ namespace nil {
                             return value_;
                         }
 
-                        std::size_t length() {
-                            return cur_length;
+                        /// @brief Get number of bytes the current value is serialized into.
+                        /// @details Always computed from the current value, so it stays correct after
+                        ///     the value was modified through value().
+                        std::size_t length() const {
+                            return crypto3::marshalling::processing::length(value_);
                         }
 
                         static constexpr std::size_t min_length() {
                             return 0;
                         }
 
-                        constexpr std::size_t bit_length() {
-                            return boost::multiprecision::msb(value_) + 1;
+                        /// @brief Get number of bits the current value is serialized into.
+                        std::size_t bit_length() const {
+                            return crypto3::marshalling::processing::bit_length(value_);
                         }
 
                         // static constexpr std::size_t max_length() {
@@ -115,7 +125,6 @@ namespace nil {
 
                             read_no_status(iter, size);
                             iter += size;
-                            cur_length += size;
                             return nil::marshalling::status_type::success;
                         }
 
@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_INTEGRAL_ENCODING_CACHE_HPP
+#define CRYPTO3_MARSHALLING_INTEGRAL_ENCODING_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#include <nil/marshalling/types/detail/adapt_basic_field.hpp>
+#include <nil/marshalling/types/detail/options_parser.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/options.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace types {
+                namespace detail {
+                    /// @brief Separates @ref nil::crypto3::marshalling::option::cached_encoding from
+                    ///     the other field options, which are forwarded to the generic field adapter.
+                    /// @tparam TKept std::tuple of the options kept so far.
+                    template<typename TKept, typename... TOptions>
+                    struct integral_options_splitter;
+
+                    template<typename... TKept>
+                    struct integral_options_splitter<std::tuple<TKept...>> {
+                        static constexpr bool has_cached_encoding = false;
+
+                        using parsed_options_type = ::nil::marshalling::types::detail::options_parser<TKept...>;
+
+                        template<typename TBasicField>
+                        using adapted_type =
+                            ::nil::marshalling::types::detail::adapt_basic_field_type<TBasicField, TKept...>;
+                    };
+
+                    template<typename... TKept, typename TOption, typename... TRest>
+                    struct integral_options_splitter<std::tuple<TKept...>, TOption, TRest...>
+                        : public integral_options_splitter<std::tuple<TKept..., TOption>, TRest...> { };
+
+                    template<typename... TKept, typename... TRest>
+                    struct integral_options_splitter<std::tuple<TKept...>, option::cached_encoding, TRest...>
+                        : public integral_options_splitter<std::tuple<TKept...>, TRest...> {
+                        static constexpr bool has_cached_encoding = true;
+                    };
+
+                    /// @brief Storage of the encoded field value.
+                    /// @details Empty unless the encoding is cached, so that fields without the
+                    ///     option do not grow.
+                    template<bool TEnabled>
+                    class integral_encoding_cache {
+                    protected:
+                        void reset_encoding() {
+                        }
+                    };
+
+                    template<>
+                    class integral_encoding_cache<true> {
+                    public:
+                        /// @brief Shared handle to the immutable encoded value.
+                        using encoded_buffer_type = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+                        integral_encoding_cache() = default;
+
+                        integral_encoding_cache(const integral_encoding_cache &other) :
+                            encoded_(other.load_encoding()) {
+                        }
+
+                        integral_encoding_cache &operator=(const integral_encoding_cache &other) {
+                            store_encoding(other.load_encoding());
+                            return *this;
+                        }
+
+                    protected:
+                        void reset_encoding() {
+                            store_encoding(nullptr);
+                        }
+
+                        encoded_buffer_type load_encoding() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+                            return encoded_.load(std::memory_order_acquire);
+#else
+                            return std::atomic_load_explicit(&encoded_, std::memory_order_acquire);
+#endif
+                        }
+
+                        /// @brief Publishes the encoding unless another thread has done it first.
+                        /// @return The published encoding, which every caller shares.
+                        encoded_buffer_type publish_encoding(encoded_buffer_type buffer) const {
+                            encoded_buffer_type expected;
+#if defined(__cpp_lib_atomic_shared_ptr)
+                            if (encoded_.compare_exchange_strong(expected, buffer, std::memory_order_acq_rel,
+                                                                 std::memory_order_acquire)) {
+#else
+                            if (std::atomic_compare_exchange_strong_explicit(&encoded_, &expected, buffer,
+                                                                             std::memory_order_acq_rel,
+                                                                             std::memory_order_acquire)) {
+#endif
+                                return buffer;
+                            }
+                            return expected;
+                        }
+
+                    private:
+                        void store_encoding(encoded_buffer_type buffer) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+                            encoded_.store(std::move(buffer), std::memory_order_release);
+#else
+                            std::atomic_store_explicit(&encoded_, std::move(buffer), std::memory_order_release);
+#endif
+                        }
+
+                        // Filled lazily by const accessors, hence accessed atomically only
+#if defined(__cpp_lib_atomic_shared_ptr)
+                        mutable std::atomic<encoded_buffer_type> encoded_;
+#else
+                        mutable encoded_buffer_type encoded_;
+#endif
+                    };
+                }    // namespace detail
+            }        // namespace types
+        }            // namespace marshalling
+    }                // namespace crypto3
+}    // namespace nil
+#endif    // CRYPTO3_MARSHALLING_INTEGRAL_ENCODING_CACHE_HPP
@@ -26,9 +26,12 @@
 #ifndef CRYPTO3_MARSHALLING_INTEGRAL_HPP
 #define CRYPTO3_MARSHALLING_INTEGRAL_HPP
 
+#include <algorithm>
+#include <iterator>
 #include <ratio>
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 #include <boost/type_traits/is_integral.hpp>
 
@@ -44,6 +47,9 @@
 
 #include <nil/crypto3/marshalling/multiprecision/types/detail/integral/basic_fixed_precision_type.hpp>
 #include <nil/crypto3/marshalling/multiprecision/types/detail/integral/basic_non_fixed_precision_type.hpp>
+#include <nil/crypto3/marshalling/multiprecision/types/detail/integral/encoding_cache.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/contiguous.hpp>
+#include <nil/crypto3/marshalling/multiprecision/options.hpp>
 #include <nil/crypto3/marshalling/multiprecision/inference.hpp>
 
 namespace nil {
@@ -91,6 +97,7 @@ namespace nil {
                 ///     @li nil::marshalling::option::empty_serialization
                 ///     @li @ref nil::marshalling::option::invalid_by_default
                 ///     @li @ref nil::marshalling::option::version_storage
+                ///     @li @ref nil::crypto3::marshalling::option::cached_encoding
                 /// @extends nil::marshalling::field_type
                 /// @headerfile nil/marshalling/types/integral.hpp
                 template<typename TTypeBase, typename IntegralContainer, typename... TOptions>
@@ -101,13 +108,25 @@ namespace nil {
                          boost::multiprecision::expression_template_option ExpressionTemplates,
                          typename... TOptions>
                 class integral<TTypeBase, boost::multiprecision::number<Backend, ExpressionTemplates>, TOptions...>
-                    : public ::nil::marshalling::types::detail::adapt_basic_field_type<
-                          crypto3::marshalling::types::detail::basic_integral<TTypeBase, Backend, ExpressionTemplates>,
-                          TOptions...> {
+                    : public detail::integral_options_splitter<std::tuple<>, TOptions...>::template adapted_type<
+                          crypto3::marshalling::types::detail::basic_integral<TTypeBase, Backend, ExpressionTemplates>>,
+                      public detail::integral_encoding_cache<
+                          detail::integral_options_splitter<std::tuple<>, TOptions...>::has_cached_encoding> {
 
-                    using base_impl_type = ::nil::marshalling::types::detail::adapt_basic_field_type<
-                        crypto3::marshalling::types::detail::basic_integral<TTypeBase, Backend, ExpressionTemplates>,
-                        TOptions...>;
+                    using options_splitter_type = detail::integral_options_splitter<std::tuple<>, TOptions...>;
+
+                    using base_impl_type = typename options_splitter_type::template adapted_type<
+                        crypto3::marshalling::types::detail::basic_integral<TTypeBase, Backend, ExpressionTemplates>>;
+
+                    using cache_type = detail::integral_encoding_cache<options_splitter_type::has_cached_encoding>;
+
+                    template<typename TIter>
+                    static constexpr bool is_cached_write() {
+                        // The cache holds bytes, so it is of no use for wider or bit units
+                        return options_splitter_type::has_cached_encoding &&
+                               processing::detail::is_byte_unit<
+                                   typename std::iterator_traits<TIter>::value_type>::value;
+                    }
 
                 public:
                     /// @brief endian_type used for serialization.
@@ -117,7 +136,12 @@ namespace nil {
                     using version_type = typename base_impl_type::version_type;
 
                     /// @brief All the options provided to this class bundled into struct.
-                    using parsed_options_type = ::nil::marshalling::types::detail::options_parser<TOptions...>;
+                    /// @details Doesn't include @ref nil::crypto3::marshalling::option::cached_encoding,
+                    ///     see @ref has_cached_encoding.
+                    using parsed_options_type = typename options_splitter_type::parsed_options_type;
+
+                    /// @brief Whether @ref nil::crypto3::marshalling::option::cached_encoding has been provided.
+                    static constexpr bool has_cached_encoding = options_splitter_type::has_cached_encoding;
 
                     /// @brief Tag indicating type of the field
                     using tag = ::nil::marshalling::types::tag::integral;
@@ -149,33 +173,46 @@ namespace nil {
                     }
 
                     /// @brief Get access to integral value storage.
+                    /// @details Drops the cached encoding, if any, since the value may be modified
+                    ///     through the returned reference.
                     value_type &value() {
+                        cache_type::reset_encoding();
                         return base_impl_type::value();
                     }
 
-                    // /// @brief Get length required to serialise the current field value.
-                    // /// @return Number of bytes it will take to serialise the field value.
-                    // std::size_t length() {
-                    //     return base_impl_type::length();
-                    // }
-
-                    // /// @brief Get length required to serialise the current field value.
-                    // /// @return Number of bytes it will take to serialise the field value.
-                    // static constexpr std::size_t bit_length() {
-                    //     return base_impl_type::bit_length();
-                    // }
-
-                    // /// @brief Get minimal length that is required to serialise field of this type.
-                    // /// @return Minimal number of bytes required serialise the field value.
-                    // static constexpr std::size_t min_length() {
-                    //     return base_impl_type::min_length();
-                    // }
-
-                    // /// @brief Get maximal length that is required to serialise field of this type.
-                    // /// @return Maximal number of bytes required serialise the field value.
-                    // static constexpr std::size_t max_length() {
-                    //     return base_impl_type::max_length();
-                    // }
+                    /// @brief Get the encoded field value.
+                    /// @details Exists only if @ref nil::crypto3::marshalling::option::cached_encoding
+                    ///     option has been provided. The encoding is computed on the first call after
+                    ///     the value has changed; the returned buffer is never modified afterwards, so
+                    ///     it may be kept and shared by any number of pending sends. Concurrent calls
+                    ///     on a field that isn't modified meanwhile are safe: they may each compute the
+                    ///     encoding, but all of them return the one published first.
+                    /// @return Shared handle to length() bytes, as written by write().
+                    template<bool TEnabled = has_cached_encoding, typename = typename std::enable_if<TEnabled>::type>
+                    typename detail::integral_encoding_cache<TEnabled>::encoded_buffer_type encoded() const {
+                        typename cache_type::encoded_buffer_type result = cache_type::load_encoding();
+                        if (!result) {
+                            auto buffer = std::make_shared<std::vector<std::uint8_t>>(base_impl_type::length());
+                            auto iter = buffer->begin();
+                            base_impl_type::write_no_status(iter);
+                            result = cache_type::publish_encoding(std::move(buffer));
+                        }
+                        return result;
+                    }
+
+                    /// @brief Get length required to serialise the current field value.
+                    /// @details Static for fixed precision values, computed from the current value
+                    ///     otherwise.
+                    /// @return Number of bytes it will take to serialise the field value.
+                    using base_impl_type::length;
+
+                    /// @brief Get length in bits required to serialise the current field value.
+                    /// @return Number of bits it will take to serialise the field value.
+                    using base_impl_type::bit_length;
+
+                    /// @brief Get minimal length that is required to serialise field of this type.
+                    /// @return Minimal number of bytes required serialise the field value.
+                    using base_impl_type::min_length;
 
                     /// @brief Check validity of the field value.
                     bool valid() const {
@@ -185,7 +222,11 @@ namespace nil {
                     /// @brief Refresh the field's value
                     /// @return @b true if the value has been updated, @b false otherwise
                     bool refresh() {
-                        return base_impl_type::refresh();
+                        if (!base_impl_type::refresh()) {
+                            return false;
+                        }
+                        cache_type::reset_encoding();
+                        return true;
                     }
 
                     /// @brief Read field value from input data sequence
@@ -195,6 +236,7 @@ namespace nil {
                     /// @post Iterator is advanced.
                     template<typename TIter>
                     nil::marshalling::status_type read(TIter &iter, std::size_t size) {
+                        cache_type::reset_encoding();
                         return base_impl_type::read(iter, size);
                     }
 
@@ -205,17 +247,35 @@ namespace nil {
                     /// @post Iterator is advanced.
                     template<typename TIter>
                     void read_no_status(TIter &iter) {
+                        cache_type::reset_encoding();
                         base_impl_type::read_no_status(iter);
                     }
 
                     /// @brief Write current field value to output data sequence
+                    /// @details With @ref nil::crypto3::marshalling::option::cached_encoding the bytes
+                    ///     of encoded() are copied to the output instead of encoding the value again.
                     /// @param[in, out] iter Iterator to write the data.
                     /// @param[in] size Maximal number of bytes that can be written.
                     /// @return Status of write operation.
                     /// @post Iterator is advanced.
                     template<typename TIter>
                     nil::marshalling::status_type write(TIter &iter, std::size_t size) const {
-                        return base_impl_type::write(iter, size);
+                        if constexpr (is_cached_write<TIter>()) {
+                            constexpr bool is_fixed_precision =
+                                boost::multiprecision::backends::is_fixed_precision<Backend>::value;
+
+                            const std::vector<std::uint8_t> &bytes = *this->encoded();
+                            if (is_fixed_precision && size < bytes.size()) {
+                                return nil::marshalling::status_type::buffer_overflow;
+                            }
+
+                            std::copy(bytes.begin(), bytes.end(), iter);
+                            // Same advance as the uncached write
+                            iter += is_fixed_precision ? bytes.size() : size;
+                            return nil::marshalling::status_type::success;
+                        } else {
+                            return base_impl_type::write(iter, size);
+                        }
                     }
 
                     /// @brief Write current field value to output data sequence  without error check and status report.
@@ -225,7 +285,12 @@ namespace nil {
                     /// @post Iterator is advanced.
                     template<typename TIter>
                     void write_no_status(TIter &iter) const {
-                        base_impl_type::write_no_status(iter);
+                        if constexpr (is_cached_write<TIter>()) {
+                            const std::vector<std::uint8_t> &bytes = *this->encoded();
+                            std::copy(bytes.begin(), bytes.end(), iter);
+                        } else {
+                            base_impl_type::write_no_status(iter);
+                        }
                     }
 
                     /// @brief Compile time check if this class is version dependent
@@ -242,7 +307,11 @@ namespace nil {
                     /// @brief Default implementation of version update.
                     /// @return @b true in case the field contents have changed, @b false otherwise
                     bool set_version(version_type version) {
-                        return base_impl_type::set_version(version);
+                        if (!base_impl_type::set_version(version)) {
+                            return false;
+                        }
+                        cache_type::reset_encoding();
+                        return true;
                     }
 
                 protected:
@@ -399,6 +468,30 @@ namespace nil {
                     return field;
                 }
 
+                /// @brief Get length required to serialise all the values of the container.
+                /// @details Fixed precision values take the same number of bytes each, so the result is
+                ///     computed in constant time. Otherwise the lengths of the values are summed up.
+                ///     Allows to allocate the output buffer of the exact size before the encoding.
+                /// @param[in] values Container of integral values.
+                /// @return Number of bytes it will take to serialise all the values.
+                template<typename Backend, boost::multiprecision::expression_template_option ExpressionTemplates>
+                std::size_t total_length(
+                    const std::vector<boost::multiprecision::number<Backend, ExpressionTemplates>> &values) {
+                    if constexpr (boost::multiprecision::backends::is_fixed_precision<Backend>::value) {
+                        using basic_type = detail::basic_integral<
+                            nil::marshalling::field_type<nil::marshalling::option::big_endian>, Backend,
+                            ExpressionTemplates>;
+
+                        return values.size() * basic_type::max_length();
+                    } else {
+                        std::size_t result = 0;
+                        for (const auto &value : values) {
+                            result += processing::length(value);
+                        }
+                        return result;
+                    }
+                }
+
                 template<typename IntegralContainer, typename Endianness>
                 nil::marshalling::types::array_list<
                     nil::marshalling::field_type<Endianness>,
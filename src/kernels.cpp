@@ -0,0 +1,61 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2017-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/kernels.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace processing {
+                namespace detail {
+                    template std::uint8_t *write_limbs_bytes_big_endian(const unsigned *, std::size_t,
+                                                                        std::uint8_t *);
+                    template std::uint8_t *write_limbs_bytes_big_endian(const unsigned long *, std::size_t,
+                                                                        std::uint8_t *);
+                    template std::uint8_t *write_limbs_bytes_big_endian(const unsigned long long *, std::size_t,
+                                                                        std::uint8_t *);
+                    template std::uint8_t *write_limbs_bytes_little_endian(const unsigned *, std::size_t,
+                                                                           std::uint8_t *);
+                    template std::uint8_t *write_limbs_bytes_little_endian(const unsigned long *, std::size_t,
+                                                                           std::uint8_t *);
+                    template std::uint8_t *write_limbs_bytes_little_endian(const unsigned long long *, std::size_t,
+                                                                           std::uint8_t *);
+                    template const std::uint8_t *read_limbs_bytes_big_endian(const std::uint8_t *, std::size_t,
+                                                                             unsigned *);
+                    template const std::uint8_t *read_limbs_bytes_big_endian(const std::uint8_t *, std::size_t,
+                                                                             unsigned long *);
+                    template const std::uint8_t *read_limbs_bytes_big_endian(const std::uint8_t *, std::size_t,
+                                                                             unsigned long long *);
+                    template const std::uint8_t *read_limbs_bytes_little_endian(const std::uint8_t *, std::size_t,
+                                                                                unsigned *);
+                    template const std::uint8_t *read_limbs_bytes_little_endian(const std::uint8_t *, std::size_t,
+                                                                                unsigned long *);
+                    template const std::uint8_t *read_limbs_bytes_little_endian(const std::uint8_t *, std::size_t,
+                                                                                unsigned long long *);
+                }    // namespace detail
+            }        // namespace processing
+        }            // namespace marshalling
+    }                // namespace crypto3
+}    // namespace nil
@@ -0,0 +1,119 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Measures how dumping a large encoded output affects a concurrent cache bound workload,
+// with regular and with non-temporal stores.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/non_temporal.hpp>
+
+using value_type = boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<256>>;
+
+constexpr std::size_t values_count = std::size_t(1) << 22;
+constexpr std::size_t working_set_size = std::size_t(1) << 20;
+constexpr std::size_t dumps_count = 8;
+
+volatile std::uint64_t workload_sink;
+
+struct result_type {
+    double dump_seconds;
+    double workload_passes_per_second;
+};
+
+/// Walks the working set over and over, as arithmetic threads do with their tables.
+std::size_t run_workload(const std::vector<std::uint64_t> &working_set, const std::atomic<bool> &stop) {
+    std::size_t passes = 0;
+    std::uint64_t index = 0;
+    std::uint64_t checksum = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+        for (std::size_t i = 0; i < working_set.size(); ++i) {
+            index = working_set[(index + i) % working_set.size()];
+            checksum += index;
+        }
+        ++passes;
+    }
+    workload_sink = checksum;
+    return passes;
+}
+
+result_type measure(const std::vector<value_type> &values, std::vector<std::uint8_t> &output,
+                    std::size_t threshold) {
+    using namespace nil::crypto3::marshalling;
+
+    std::vector<std::uint64_t> working_set(working_set_size / sizeof(std::uint64_t));
+    for (std::size_t i = 0; i < working_set.size(); ++i) {
+        working_set[i] = (i * 2654435761u) % working_set.size();
+    }
+
+    std::atomic<bool> stop(false);
+    std::size_t passes = 0;
+    std::thread workload([&]() { passes = run_workload(working_set, stop); });
+
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < dumps_count; ++i) {
+        processing::write_non_temporal<nil::marshalling::endian::big_endian>(values.begin(), values.end(),
+                                                                             output.data(), threshold);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    stop = true;
+    workload.join();
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    return {seconds / dumps_count, passes / seconds};
+}
+
+int main() {
+    std::vector<value_type> values(values_count);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = value_type(i) * value_type(0x9E3779B97F4A7C15ULL) + value_type(i);
+    }
+    std::vector<std::uint8_t> output(values.size() * 32);
+
+    result_type regular = measure(values, output, std::numeric_limits<std::size_t>::max());
+    result_type non_temporal = measure(values, output, 0);
+
+    double output_gb = output.size() / 1e9;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "regular stores:      " << output_gb / regular.dump_seconds << " GB/s dump, "
+              << regular.workload_passes_per_second << " workload passes/s" << std::endl;
+    std::cout << "non-temporal stores: " << output_gb / non_temporal.dump_seconds << " GB/s dump, "
+              << non_temporal.workload_passes_per_second << " workload passes/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_bit_decomposition_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/bit_decomposition.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<class T>
+void test_bit_decomposition(std::size_t count, std::size_t threads_count) {
+    using namespace nil::crypto3::marshalling;
+
+    constexpr std::size_t bits = processing::detail::limb_traits<T>::bits;
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < count; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+
+    std::size_t row_words = processing::bit_matrix_row_words<T>();
+    std::size_t column_words = processing::bit_matrix_column_words(count);
+
+    std::vector<processing::bit_matrix_word_type> rows(
+        processing::bit_matrix_words_count<T>(count, processing::bit_matrix_layout::row_major));
+    processing::bit_decompose(val_container.begin(), val_container.end(), rows.data(),
+                              processing::bit_matrix_layout::row_major, threads_count);
+
+    std::vector<processing::bit_matrix_word_type> columns(
+        processing::bit_matrix_words_count<T>(count, processing::bit_matrix_layout::column_major));
+    processing::bit_decompose(val_container.begin(), val_container.end(), columns.data(),
+                              processing::bit_matrix_layout::column_major, threads_count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        for (std::size_t j = 0; j < bits; j++) {
+            bool bit = boost::multiprecision::bit_test(val_container[i], j);
+            BOOST_CHECK_EQUAL(bool((rows[i * row_words + j / 64] >> (j % 64)) & 1), bit);
+            BOOST_CHECK_EQUAL(bool((columns[j * column_words + i / 64] >> (i % 64)) & 1), bit);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(bit_decomposition_test_suite)
+
+BOOST_AUTO_TEST_CASE(bit_decomposition_cpp_uint512) {
+    test_bit_decomposition<boost::multiprecision::uint512_modular_t>(200, 1);
+    test_bit_decomposition<boost::multiprecision::uint512_modular_t>(1000, 4);
+}
+
+BOOST_AUTO_TEST_CASE(bit_decomposition_cpp_int_backend_255) {
+    test_bit_decomposition<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<255>>>(130, 3);
+}
+
+BOOST_AUTO_TEST_CASE(bit_decomposition_cpp_int_backend_23) {
+    test_bit_decomposition<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>>(70, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
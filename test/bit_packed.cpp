@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_bit_packed_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/bit_packed.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<class T>
+void test_bit_packed_round_trip(std::size_t count) {
+    using namespace nil::crypto3::marshalling;
+
+    constexpr std::size_t bits = std::numeric_limits<T>::digits;
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < count; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+
+    std::size_t length = processing::bit_packed_length<T>(count);
+    BOOST_CHECK_EQUAL(length, (count * bits + 7) / 8);
+
+    std::vector<unsigned char> cv(length + 1, 0xAA);
+    auto write_iter = cv.begin();
+    processing::write_bit_packed(val_container.begin(), val_container.end(), write_iter);
+    BOOST_CHECK(write_iter == cv.begin() + length);
+    BOOST_CHECK_EQUAL(cv[length], 0xAA);
+
+    std::vector<T> test_val_container(count);
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(processing::read_bit_packed(read_iter, length, test_val_container.begin(),
+                                            test_val_container.end()) == nil::marshalling::status_type::success);
+    BOOST_CHECK(read_iter == cv.cbegin() + length);
+    BOOST_CHECK(test_val_container == val_container);
+
+    if (count) {
+        read_iter = cv.cbegin();
+        BOOST_CHECK(processing::read_bit_packed(read_iter, length - 1, test_val_container.begin(),
+                                                test_val_container.end()) ==
+                    nil::marshalling::status_type::not_enough_data);
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        BOOST_CHECK(processing::read_bit_packed_element<T>(cv.cbegin(), i) == val_container[i]);
+    }
+
+    for (std::size_t i = 0; i < count; i += 3) {
+        val_container[i] = generate_random<T>();
+        processing::write_bit_packed_element(val_container[i], cv.begin(), i);
+    }
+    read_iter = cv.cbegin();
+    BOOST_CHECK(processing::read_bit_packed(read_iter, length, test_val_container.begin(),
+                                            test_val_container.end()) == nil::marshalling::status_type::success);
+    BOOST_CHECK(test_val_container == val_container);
+    BOOST_CHECK_EQUAL(cv[length], 0xAA);
+}
+
+template<class T>
+void test_bit_packed_round_trip() {
+    for (std::size_t count : {0, 1, 2, 7, 8, 65, 256}) {
+        test_bit_packed_round_trip<T>(count);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(bit_packed_test_suite)
+
+BOOST_AUTO_TEST_CASE(bit_packed_layout) {
+    using namespace nil::crypto3::marshalling;
+    using T = boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<5>>;
+
+    std::vector<T> val_container = {T(1), T(2), T(3)};
+    std::vector<unsigned char> cv(processing::bit_packed_length<T>(val_container.size()));
+    BOOST_CHECK_EQUAL(cv.size(), 2);
+
+    auto write_iter = cv.begin();
+    processing::write_bit_packed(val_container.begin(), val_container.end(), write_iter);
+    // 1 | 2 << 5 | 3 << 10
+    BOOST_CHECK_EQUAL(cv[0], 0x41);
+    BOOST_CHECK_EQUAL(cv[1], 0x0C);
+}
+
+BOOST_AUTO_TEST_CASE(bit_packed_cpp_uint512) {
+    test_bit_packed_round_trip<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(bit_packed_cpp_int_backend_254) {
+    test_bit_packed_round_trip<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<254>>>();
+}
+
+BOOST_AUTO_TEST_CASE(bit_packed_cpp_int_backend_64) {
+    test_bit_packed_round_trip<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>>();
+}
+
+BOOST_AUTO_TEST_CASE(bit_packed_cpp_int_backend_23) {
+    test_bit_packed_round_trip<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>>();
+}
+
+BOOST_AUTO_TEST_CASE(bit_packed_cpp_int_backend_5) {
+    test_bit_packed_round_trip<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<5>>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,187 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_block_packed_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/block_packed.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<typename Endianness, class T>
+void test_block_packed_round_trip(const std::vector<T> &val_container) {
+    using namespace nil::crypto3::marshalling;
+
+    std::size_t length = processing::block_packed_length(val_container.begin(), val_container.end());
+    std::vector<unsigned char> cv(length + 1, 0xAA);
+    auto write_iter = cv.begin();
+    processing::write_block_packed<Endianness>(val_container.begin(), val_container.end(), write_iter);
+    BOOST_CHECK(write_iter == cv.begin() + length);
+    BOOST_CHECK_EQUAL(cv.back(), 0xAA);
+
+    std::vector<T> test_val_container(val_container.size());
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(processing::read_block_packed<Endianness>(read_iter, length, test_val_container.begin(),
+                                                          test_val_container.end()) ==
+                nil::marshalling::status_type::success);
+    BOOST_CHECK(read_iter == cv.cbegin() + length);
+    BOOST_CHECK(test_val_container == val_container);
+
+    for (std::size_t block_index = 0; block_index * processing::block_packed_block_size < val_container.size();
+         block_index++) {
+        std::vector<T> block;
+        nil::marshalling::status_type status = processing::read_block_packed_block<Endianness, T>(
+            cv.cbegin(), length, block_index, std::back_inserter(block));
+        BOOST_CHECK(status == nil::marshalling::status_type::success);
+        std::size_t expected_first = block_index * processing::block_packed_block_size;
+        std::size_t expected_last =
+            std::min(val_container.size(), expected_first + processing::block_packed_block_size);
+        BOOST_CHECK(std::equal(block.begin(), block.end(), val_container.begin() + expected_first,
+                               val_container.begin() + expected_last));
+    }
+
+    // The table is parsed once for all the blocks
+    processing::block_packed_index<T> index;
+    auto index_iter = cv.cbegin();
+    BOOST_CHECK(index.template read<Endianness>(index_iter, length) == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(index.count(), val_container.size());
+    BOOST_CHECK_EQUAL(index.length(), length);
+    BOOST_CHECK(index_iter == cv.cbegin() + sizeof(processing::block_packed_count_type) +
+                                  index.blocks_count() * sizeof(processing::block_packed_width_type));
+    for (std::size_t block_index = index.blocks_count(); block_index > 0; block_index--) {
+        std::vector<T> block;
+        BOOST_CHECK(index.read_block(cv.cbegin(), block_index - 1, std::back_inserter(block)) ==
+                    nil::marshalling::status_type::success);
+        BOOST_CHECK_EQUAL(block.size(), index.block_count(block_index - 1));
+        BOOST_CHECK(std::equal(block.begin(), block.end(),
+                               val_container.begin() + (block_index - 1) * processing::block_packed_block_size));
+    }
+    std::vector<T> missing_block;
+    BOOST_CHECK(index.read_block(cv.cbegin(), index.blocks_count(), std::back_inserter(missing_block)) ==
+                nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(missing_block.empty());
+
+    index_iter = cv.cbegin();
+    BOOST_CHECK(index.template read<Endianness>(index_iter, length - 1) ==
+                nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK_EQUAL(index.blocks_count(), 0);
+
+    read_iter = cv.cbegin();
+    BOOST_CHECK(processing::read_block_packed<Endianness>(read_iter, length - 1, test_val_container.begin(),
+                                                          test_val_container.end()) ==
+                nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK(read_iter == cv.cbegin());
+
+    test_val_container.emplace_back();
+    BOOST_CHECK(processing::read_block_packed<Endianness>(read_iter, length, test_val_container.begin(),
+                                                          test_val_container.end()) ==
+                nil::marshalling::status_type::invalid_msg_data);
+}
+
+template<typename Endianness, class T>
+void test_block_packed_fixed_precision(std::size_t count) {
+    using namespace nil::crypto3::marshalling;
+
+    constexpr std::size_t bits = std::numeric_limits<T>::digits;
+
+    for (std::size_t width : {std::size_t(0), std::size_t(1), std::size_t(16), std::size_t(40), std::size_t(64),
+                              std::size_t(65), bits}) {
+        if (width > bits) {
+            continue;
+        }
+
+        std::vector<T> val_container;
+        for (std::size_t i = 0; i < count; i++) {
+            val_container.push_back(width ? T(generate_random<T>() >> (bits - width)) : T(0));
+        }
+        test_block_packed_round_trip<Endianness>(val_container);
+
+        if (width && count == 1000) {
+            // A single wide value takes its block only to the full width
+            std::vector<T> wide_val_container = val_container;
+            wide_val_container[300] = ~T(0);
+            test_block_packed_round_trip<Endianness>(wide_val_container);
+            BOOST_CHECK_LE(processing::block_packed_length(wide_val_container.begin(), wide_val_container.end()),
+                           processing::block_packed_length(val_container.begin(), val_container.end()) +
+                               (processing::block_packed_block_size * bits) / 8);
+        }
+    }
+
+    std::vector<T> val_container(count, T(1 << 15));
+    BOOST_CHECK_EQUAL(processing::block_packed_length(val_container.begin(), val_container.end()),
+                      8 + ((count + 127) / 128) * 2 + (count / 128) * 16 * 16 + ((count % 128) * 16 + 7) / 8);
+}
+
+template<class T>
+void test_block_packed_fixed_precision() {
+    for (std::size_t count : {1, 127, 128, 129, 1000}) {
+        test_block_packed_fixed_precision<nil::marshalling::endian::big_endian, T>(count);
+        test_block_packed_fixed_precision<nil::marshalling::endian::little_endian, T>(count);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(block_packed_test_suite)
+
+BOOST_AUTO_TEST_CASE(block_packed_cpp_uint255) {
+    test_block_packed_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<255>>>();
+}
+
+BOOST_AUTO_TEST_CASE(block_packed_cpp_uint512) {
+    test_block_packed_fixed_precision<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(block_packed_cpp_int_backend_64) {
+    test_block_packed_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_chunked_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/chunked.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<typename Endianness, class T, std::size_t TSize>
+void test_chunked(const std::array<T, TSize> &val_container) {
+    using namespace nil::crypto3::marshalling;
+
+    constexpr std::size_t value_length = serialized_length<T>::value;
+
+    std::array<std::uint8_t, serialized_length<std::array<T, TSize>>::value> cv = pack<Endianness>(val_container);
+
+    for (std::size_t chunk_size : {std::size_t(1), value_length - 1, value_length, value_length + 1,
+                                   3 * value_length + 5, cv.size(), cv.size() + 100}) {
+        if (!chunk_size) {
+            continue;
+        }
+
+        chunked_serializer<Endianness, typename std::array<T, TSize>::const_iterator> serializer(
+            val_container.begin(), val_container.end());
+        BOOST_CHECK_EQUAL(serializer.total_length(), cv.size());
+        BOOST_CHECK_EQUAL(serializer.remaining_length(), cv.size());
+
+        std::vector<std::uint8_t> test_cv;
+        std::vector<std::uint8_t> chunk(chunk_size);
+        while (!serializer.done()) {
+            std::size_t size = serializer.read(chunk.data(), chunk.size());
+            BOOST_CHECK(size == chunk_size || serializer.done());
+            test_cv.insert(test_cv.end(), chunk.begin(), chunk.begin() + size);
+            // Partially consumed, the total stays put while the remaining bytes shrink
+            BOOST_CHECK_EQUAL(serializer.total_length(), cv.size());
+            BOOST_CHECK_EQUAL(serializer.remaining_length(), cv.size() - test_cv.size());
+        }
+        BOOST_CHECK_EQUAL(serializer.remaining_length(), 0);
+        BOOST_CHECK(std::equal(test_cv.begin(), test_cv.end(), cv.begin(), cv.end()));
+
+        test_cv.clear();
+        serialize_chunked<Endianness>(val_container.begin(), val_container.end(), chunk_size,
+                                      [&](const std::uint8_t *data, std::size_t size) {
+                                          BOOST_CHECK(size <= chunk_size);
+                                          test_cv.insert(test_cv.end(), data, data + size);
+                                      });
+        BOOST_CHECK(std::equal(test_cv.begin(), test_cv.end(), cv.begin(), cv.end()));
+    }
+}
+
+template<class T, std::size_t TSize>
+void test_chunked() {
+    for (unsigned i = 0; i < 16; ++i) {
+        std::array<T, TSize> val_container;
+        for (std::size_t i = 0; i < TSize; i++) {
+            val_container[i] = generate_random<T>();
+        }
+        test_chunked<nil::marshalling::option::big_endian>(val_container);
+        test_chunked<nil::marshalling::option::little_endian>(val_container);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(chunked_test_suite)
+
+BOOST_AUTO_TEST_CASE(chunked_cpp_uint512) {
+    test_chunked<boost::multiprecision::uint512_modular_t, 128>();
+}
+
+BOOST_AUTO_TEST_CASE(chunked_cpp_int_backend_23) {
+    test_chunked<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>, 128>();
+}
+
+BOOST_AUTO_TEST_CASE(chunked_empty) {
+    using namespace nil::crypto3::marshalling;
+
+    std::vector<boost::multiprecision::uint512_modular_t> val_container;
+    chunked_serializer<nil::marshalling::option::big_endian,
+                       std::vector<boost::multiprecision::uint512_modular_t>::const_iterator>
+        serializer(val_container.cbegin(), val_container.cend());
+    BOOST_CHECK(serializer.done());
+    BOOST_CHECK_EQUAL(serializer.total_length(), 0);
+    BOOST_CHECK_EQUAL(serializer.remaining_length(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_context_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/algorithms/pack.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/context.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<typename Endianness, class T>
+void test_context_fixed_precision() {
+    using namespace nil::crypto3::marshalling;
+
+    using context_type = serialization_context<Endianness, T>;
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < 128; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+
+    context_type &context = context_type::local();
+    BOOST_CHECK(&context == &context_type::local());
+
+    // Same bytes as the array_list made by fill_integral_vector()
+    auto filled = types::fill_integral_vector<T, Endianness>(val_container);
+    std::vector<std::uint8_t> cv(filled.length());
+    auto write_iter = cv.begin();
+    BOOST_CHECK(filled.write(write_iter, cv.size()) == nil::marshalling::status_type::success);
+
+    const std::vector<std::uint8_t> &buffer = context.encode(val_container);
+    BOOST_CHECK(buffer == cv);
+
+    // Encoding and decoding the same shape again reuses the storage
+    const std::uint8_t *buffer_data = buffer.data();
+    std::vector<T> test_val_container;
+    for (std::size_t round = 0; round < 3; round++) {
+        BOOST_CHECK(context.encode(val_container).data() == buffer_data);
+
+        auto read_iter = buffer.cbegin();
+        BOOST_CHECK(context.decode(read_iter, buffer.size(), test_val_container) ==
+                    nil::marshalling::status_type::success);
+        BOOST_CHECK(read_iter == buffer.cend());
+        BOOST_CHECK(test_val_container == val_container);
+    }
+
+    std::vector<std::uint8_t> single = context.encode(val_container[1]);
+    BOOST_CHECK_EQUAL(single.size(), serialized_length<T>::value);
+    BOOST_CHECK(std::equal(single.begin(), single.end(), cv.begin() + sizeof(std::size_t) + single.size()));
+    T test_val;
+    auto single_iter = single.cbegin();
+    BOOST_CHECK(context.decode(single_iter, single.size(), test_val) == nil::marshalling::status_type::success);
+    BOOST_CHECK(single_iter == single.cend());
+    BOOST_CHECK(test_val == val_container[1]);
+
+    // Truncated input leaves the destination untouched
+    for (std::size_t size : {std::size_t(0), sizeof(std::size_t), cv.size() - 1}) {
+        auto read_iter = cv.cbegin();
+        BOOST_CHECK(context.decode(read_iter, size, test_val_container) ==
+                    nil::marshalling::status_type::not_enough_data);
+        BOOST_CHECK(read_iter == cv.cbegin());
+        BOOST_CHECK(test_val_container == val_container);
+    }
+    single_iter = single.cbegin();
+    BOOST_CHECK(context.decode(single_iter, single.size() - 1, test_val) ==
+                nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK(single_iter == single.cbegin());
+}
+
+template<typename Endianness, class T>
+void test_context_non_fixed_precision() {
+    using namespace nil::crypto3::marshalling;
+
+    serialization_context<Endianness, T> context;
+    T test_val;
+    for (std::size_t i = 0; i < 1000; i++) {
+        T val = generate_random<T>();
+
+        nil::marshalling::status_type status;
+        std::vector<std::uint8_t> cv = nil::marshalling::pack<Endianness>(val, status);
+        BOOST_CHECK(status == nil::marshalling::status_type::success);
+        BOOST_CHECK(context.encode(val) == cv);
+
+        auto read_iter = cv.cbegin();
+        BOOST_CHECK(context.decode(read_iter, cv.size(), test_val) == nil::marshalling::status_type::success);
+        BOOST_CHECK(read_iter == cv.cend());
+        BOOST_CHECK(test_val == val);
+    }
+}
+
+template<class T>
+void test_context_fixed_precision() {
+    test_context_fixed_precision<nil::marshalling::option::big_endian, T>();
+    test_context_fixed_precision<nil::marshalling::option::little_endian, T>();
+}
+
+template<class T>
+void test_context_non_fixed_precision() {
+    test_context_non_fixed_precision<nil::marshalling::option::big_endian, T>();
+    test_context_non_fixed_precision<nil::marshalling::option::little_endian, T>();
+}
+
+BOOST_AUTO_TEST_SUITE(context_test_suite)
+
+BOOST_AUTO_TEST_CASE(context_cpp_uint512) {
+    test_context_fixed_precision<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(context_cpp_int_backend_64) {
+    test_context_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>>();
+}
+
+BOOST_AUTO_TEST_CASE(context_cpp_int) {
+    test_context_non_fixed_precision<boost::multiprecision::cpp_int>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
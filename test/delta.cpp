@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_delta_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/delta.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<typename Endianness, class T>
+void test_delta_round_trip(const std::vector<T> &base, const std::vector<T> &updated) {
+    using namespace nil::crypto3::marshalling;
+
+    std::vector<std::uint8_t> cv = encode_delta<Endianness>(base, updated);
+    BOOST_CHECK_EQUAL(cv.size(), delta_length(base, updated));
+
+    std::vector<T> test_val_container = base;
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(apply_delta<Endianness>(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::success);
+    BOOST_CHECK(read_iter == cv.cend());
+    BOOST_CHECK(test_val_container == updated);
+}
+
+template<typename Endianness, class T>
+void test_delta_fixed_precision() {
+    using namespace nil::crypto3::marshalling;
+
+    std::vector<T> base;
+    for (std::size_t i = 0; i < 1024; i++) {
+        base.push_back(generate_random<T>());
+    }
+
+    // Identical vectors produce the header only
+    test_delta_round_trip<Endianness>(base, base);
+    BOOST_CHECK_EQUAL(delta_length(base, base), 2 * sizeof(delta_word_type));
+
+    std::vector<T> updated = base;
+    for (std::size_t i : {0, 1, 2, 100, 500, 501, 1023}) {
+        updated[i] = generate_random<T>() + 1;
+        if (updated[i] == base[i]) {
+            updated[i] += 1;
+        }
+    }
+    test_delta_round_trip<Endianness>(base, updated);
+    BOOST_CHECK_LT(delta_length(base, updated), base.size() * serialized_length<T>::value / 32);
+
+    // Grow and shrink
+    std::vector<T> grown = updated;
+    for (std::size_t i = 0; i < 16; i++) {
+        grown.push_back(generate_random<T>());
+    }
+    test_delta_round_trip<Endianness>(base, grown);
+    test_delta_round_trip<Endianness>(grown, base);
+    test_delta_round_trip<Endianness>(std::vector<T>(), base);
+    test_delta_round_trip<Endianness>(base, std::vector<T>());
+
+    // Truncated delta leaves the vector untouched
+    std::vector<std::uint8_t> cv = encode_delta<Endianness>(base, grown);
+    for (std::size_t size : {std::size_t(0), std::size_t(8), std::size_t(24), cv.size() - 1}) {
+        std::vector<T> test_val_container = base;
+        auto read_iter = cv.cbegin();
+        BOOST_CHECK(apply_delta<Endianness>(read_iter, size, test_val_container) ==
+                    nil::marshalling::status_type::not_enough_data);
+        BOOST_CHECK(read_iter == cv.cbegin());
+        BOOST_CHECK(test_val_container == base);
+    }
+
+    // The delta appending elements doesn't apply to a shorter vector
+    std::vector<T> test_val_container(base.begin(), base.end() - 2);
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(apply_delta<Endianness>(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(read_iter == cv.cbegin());
+
+    std::vector<std::uint8_t> small(cv.size() - 1);
+    auto write_iter = small.begin();
+    BOOST_CHECK(write_delta<Endianness>(base, grown, write_iter, small.size()) ==
+                nil::marshalling::status_type::buffer_overflow);
+    BOOST_CHECK(write_iter == small.begin());
+}
+
+template<class T>
+void test_delta_fixed_precision() {
+    test_delta_fixed_precision<nil::marshalling::option::big_endian, T>();
+    test_delta_fixed_precision<nil::marshalling::option::little_endian, T>();
+}
+
+BOOST_AUTO_TEST_SUITE(delta_test_suite)
+
+BOOST_AUTO_TEST_CASE(delta_cpp_uint512) {
+    test_delta_fixed_precision<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(delta_cpp_int_backend_64) {
+    test_delta_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
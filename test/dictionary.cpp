@@ -0,0 +1,183 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_dictionary_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/dictionary.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<typename Endianness, class T>
+void test_dictionary_round_trip(const std::vector<T> &val_container) {
+    using namespace nil::crypto3::marshalling;
+
+    std::vector<std::uint8_t> cv = encode_dictionary<Endianness>(val_container);
+    BOOST_CHECK_EQUAL(cv.size(), dictionary_length(val_container));
+
+    std::vector<std::uint8_t> written(cv.size());
+    auto write_iter = written.begin();
+    BOOST_CHECK(write_dictionary<Endianness>(val_container, write_iter, written.size()) ==
+                nil::marshalling::status_type::success);
+    BOOST_CHECK(write_iter == written.end());
+    BOOST_CHECK(written == cv);
+
+    std::vector<T> test_val_container;
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(read_dictionary<Endianness>(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::success);
+    BOOST_CHECK(read_iter == cv.cend());
+    BOOST_CHECK(test_val_container == val_container);
+
+    if (!cv.empty()) {
+        read_iter = cv.cbegin();
+        BOOST_CHECK(read_dictionary<Endianness>(read_iter, cv.size() - 1, test_val_container) ==
+                    nil::marshalling::status_type::not_enough_data);
+        BOOST_CHECK(read_iter == cv.cbegin());
+        BOOST_CHECK(test_val_container == val_container);
+    }
+}
+
+template<typename Endianness, class T>
+void test_dictionary_fixed_precision() {
+    using namespace nil::crypto3::marshalling;
+
+    for (std::size_t distinct_count : {1, 2, 3, 5, 17, 300}) {
+        std::vector<T> dictionary;
+        for (std::size_t i = 0; i < distinct_count; i++) {
+            dictionary.push_back(generate_random<T>());
+        }
+
+        for (std::size_t count : {0, 1, 7, 1000}) {
+            std::vector<T> val_container;
+            for (std::size_t i = 0; i < count; i++) {
+                val_container.push_back(dictionary[(i * 7 + i / 3) % distinct_count]);
+            }
+            test_dictionary_round_trip<Endianness>(val_container);
+        }
+    }
+
+    std::vector<T> val_container(4096, T(0));
+    for (std::size_t i = 0; i < val_container.size(); i += 3) {
+        val_container[i] = T(1);
+    }
+    test_dictionary_round_trip<Endianness>(val_container);
+    BOOST_CHECK_EQUAL(dictionary_length(val_container),
+                      2 * sizeof(dictionary_count_type) + 2 * serialized_length<T>::value + 4096 / 8);
+}
+
+template<class T>
+void test_dictionary_fixed_precision() {
+    test_dictionary_fixed_precision<nil::marshalling::option::big_endian, T>();
+    test_dictionary_fixed_precision<nil::marshalling::option::little_endian, T>();
+}
+
+BOOST_AUTO_TEST_SUITE(dictionary_test_suite)
+
+BOOST_AUTO_TEST_CASE(dictionary_cpp_uint512) {
+    test_dictionary_fixed_precision<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(dictionary_cpp_int_backend_64) {
+    test_dictionary_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>>();
+}
+
+BOOST_AUTO_TEST_CASE(dictionary_index_out_of_range) {
+    using namespace nil::crypto3::marshalling;
+    using T = boost::multiprecision::uint512_modular_t;
+
+    std::vector<T> val_container = {T(1), T(2), T(3), T(1)};
+    std::vector<std::uint8_t> cv = encode_dictionary<nil::marshalling::option::big_endian>(val_container);
+
+    // Index 3 with the dictionary of 3 values
+    cv.back() |= 0x03;
+    std::vector<T> test_val_container;
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(read_dictionary<nil::marshalling::option::big_endian>(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(read_iter == cv.cbegin());
+    BOOST_CHECK(test_val_container.empty());
+}
+
+BOOST_AUTO_TEST_CASE(dictionary_count_out_of_range) {
+    using namespace nil::crypto3::marshalling;
+    using T = boost::multiprecision::uint512_modular_t;
+
+    // Indices of a single entry dictionary still take a bit each
+    std::vector<T> val_container(10, T(7));
+    std::vector<std::uint8_t> cv = encode_dictionary<nil::marshalling::option::big_endian>(val_container);
+    BOOST_CHECK_EQUAL(cv.size(), 2 * sizeof(dictionary_count_type) + serialized_length<T>::value + 2);
+
+    // So a huge count is rejected by the input size before anything is allocated
+    std::fill(cv.begin(), cv.begin() + sizeof(dictionary_count_type), 0xFF);
+    std::vector<T> test_val_container;
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(read_dictionary<nil::marshalling::option::big_endian>(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK(read_iter == cv.cbegin());
+    BOOST_CHECK(test_val_container.empty());
+
+    // Index 1 with the dictionary of a single value
+    cv = encode_dictionary<nil::marshalling::option::big_endian>(val_container);
+    cv.back() |= 0x01;
+    read_iter = cv.cbegin();
+    BOOST_CHECK(read_dictionary<nil::marshalling::option::big_endian>(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(test_val_container.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_hash_sink_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/algorithms/pack.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/hash_sink.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+struct collecting_absorber {
+    void operator()(const std::uint8_t *data, std::size_t size) {
+        blocks.push_back(size);
+        absorbed.insert(absorbed.end(), data, data + size);
+    }
+
+    std::vector<std::size_t> blocks;
+    std::vector<std::uint8_t> absorbed;
+};
+
+template<typename Endianness, class T, std::size_t BlockSize>
+void test_hash_sink_integral(T val) {
+    using namespace nil::crypto3::marshalling;
+    using integral_type = types::integral<nil::marshalling::field_type<Endianness>, T>;
+
+    nil::marshalling::status_type status;
+    std::vector<std::uint8_t> cv = nil::marshalling::pack<Endianness>(val, status);
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+
+    hash_sink<collecting_absorber, BlockSize> sink {collecting_absorber()};
+    absorb(sink, integral_type(val));
+    sink.flush();
+
+    BOOST_CHECK(sink.absorber().absorbed == cv);
+    for (std::size_t block : sink.absorber().blocks) {
+        BOOST_CHECK(block <= BlockSize);
+    }
+}
+
+template<typename Endianness, class T, std::size_t BlockSize>
+void test_hash_sink_integral_vector(const std::vector<T> &val_container) {
+    using namespace nil::crypto3::marshalling;
+
+    auto filled = types::fill_integral_vector<T, Endianness>(val_container);
+
+    std::vector<std::uint8_t> cv(filled.length());
+    auto write_iter = cv.begin();
+    nil::marshalling::status_type status = filled.write(write_iter, cv.size());
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+
+    hash_sink<collecting_absorber, BlockSize> sink {collecting_absorber()};
+    absorb(sink, filled);
+    sink.flush();
+
+    BOOST_CHECK(sink.absorber().absorbed == cv);
+}
+
+template<class T, std::size_t BlockSize>
+void test_hash_sink() {
+    for (unsigned i = 0; i < 128; ++i) {
+        T val = generate_random<T>();
+        test_hash_sink_integral<nil::marshalling::option::big_endian, T, BlockSize>(val);
+        test_hash_sink_integral<nil::marshalling::option::little_endian, T, BlockSize>(val);
+    }
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < 64; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+    test_hash_sink_integral_vector<nil::marshalling::option::big_endian, T, BlockSize>(val_container);
+    test_hash_sink_integral_vector<nil::marshalling::option::little_endian, T, BlockSize>(val_container);
+}
+
+BOOST_AUTO_TEST_SUITE(hash_sink_test_suite)
+
+BOOST_AUTO_TEST_CASE(hash_sink_cpp_uint512) {
+    test_hash_sink<boost::multiprecision::uint512_modular_t, 64>();
+    test_hash_sink<boost::multiprecision::uint512_modular_t, 7>();
+}
+
+BOOST_AUTO_TEST_CASE(hash_sink_cpp_int_backend_23) {
+    test_hash_sink<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>, 64>();
+    test_hash_sink<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>, 1>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
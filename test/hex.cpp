@@ -0,0 +1,162 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_hex_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/algorithms/hex.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<class T>
+std::string reference_hex(const T &val, std::size_t width, bool upper_case = false) {
+    std::ostringstream stream;
+    stream << std::hex;
+    if (upper_case) {
+        stream << std::uppercase;
+    }
+    stream << val;
+    std::string result = stream.str();
+    if (result.size() < width) {
+        result.insert(0, width - result.size(), '0');
+    }
+    return result;
+}
+
+template<class T>
+void test_hex_fixed_precision() {
+    using namespace nil::crypto3::marshalling;
+
+    constexpr std::size_t bits = std::numeric_limits<T>::digits;
+    constexpr std::size_t width = 2 * (bits / 8 + ((bits % 8) ? 1 : 0));
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < 128; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+    val_container.push_back(T(0));
+    val_container.push_back(~T(0));
+
+    std::vector<std::string> hex_container;
+    encode_hex(val_container.begin(), val_container.end(), std::back_inserter(hex_container));
+    BOOST_CHECK_EQUAL(hex_container.size(), val_container.size());
+
+    for (std::size_t i = 0; i < val_container.size(); i++) {
+        BOOST_CHECK_EQUAL(hex_length(val_container[i]), width);
+        BOOST_CHECK_EQUAL(hex_container[i], reference_hex(val_container[i], width));
+
+        T test_val;
+        BOOST_CHECK(decode_hex("0x" + reference_hex(val_container[i], 0, true), test_val) ==
+                    nil::marshalling::status_type::success);
+        BOOST_CHECK(test_val == val_container[i]);
+    }
+
+    std::vector<T> test_val_container(hex_container.size());
+    BOOST_CHECK(decode_hex(hex_container.begin(), hex_container.end(), test_val_container.begin()) ==
+                nil::marshalling::status_type::success);
+    BOOST_CHECK(test_val_container == val_container);
+
+    T test_val;
+    BOOST_CHECK(decode_hex("", test_val) == nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(decode_hex("0x", test_val) == nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(decode_hex("0x12g4", test_val) == nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(decode_hex(std::string(width + 2, 'f'), test_val) == nil::marshalling::status_type::invalid_msg_data);
+    if (bits % 8) {
+        BOOST_CHECK(decode_hex(std::string(width, 'f'), test_val) == nil::marshalling::status_type::invalid_msg_data);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(hex_test_suite)
+
+BOOST_AUTO_TEST_CASE(hex_cpp_uint512) {
+    test_hex_fixed_precision<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(hex_cpp_int_backend_255) {
+    test_hex_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<255>>>();
+}
+
+BOOST_AUTO_TEST_CASE(hex_cpp_int_backend_64) {
+    test_hex_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>>();
+}
+
+BOOST_AUTO_TEST_CASE(hex_cpp_int_backend_23) {
+    test_hex_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>>();
+}
+
+BOOST_AUTO_TEST_CASE(hex_cpp_int_minimal_width) {
+    using namespace nil::crypto3::marshalling;
+
+    for (unsigned i = 0; i < 128; ++i) {
+        boost::multiprecision::cpp_int val = generate_random<boost::multiprecision::cpp_int>();
+        std::string hex = encode_hex(val);
+
+        BOOST_CHECK_EQUAL(hex.size(), hex_length(val));
+        std::string expected = reference_hex(val, 0);
+        BOOST_CHECK_EQUAL(hex, expected.size() % 2 ? "0" + expected : expected);
+
+        boost::multiprecision::cpp_int test_val;
+        BOOST_CHECK(decode_hex(hex, test_val) == nil::marshalling::status_type::success);
+        BOOST_CHECK(test_val == val);
+    }
+
+    BOOST_CHECK_EQUAL(encode_hex(boost::multiprecision::cpp_int(0)), "00");
+    BOOST_CHECK_EQUAL(encode_hex(boost::multiprecision::cpp_int(0x1ab)), "01ab");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_indexed_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/indexed.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<typename Endianness, class T>
+void test_indexed_round_trip(std::size_t count) {
+    using namespace nil::crypto3::marshalling;
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < count; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+    if (count) {
+        val_container[count / 2] = 0;
+    }
+
+    std::size_t length = processing::indexed_length(val_container.begin(), val_container.end());
+    std::vector<unsigned char> cv(length);
+    auto write_iter = cv.begin();
+    processing::write_indexed<Endianness>(val_container.begin(), val_container.end(), write_iter);
+    BOOST_CHECK(write_iter == cv.end());
+
+    for (std::size_t threads_count : {1, 4}) {
+        std::vector<T> test_val_container;
+        auto read_iter = cv.cbegin();
+        BOOST_CHECK(processing::read_indexed<Endianness>(read_iter, cv.size(), test_val_container, threads_count) ==
+                    nil::marshalling::status_type::success);
+        BOOST_CHECK(read_iter == cv.cend());
+        BOOST_CHECK(test_val_container == val_container);
+    }
+
+    std::vector<T> test_val_container;
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(processing::read_indexed<Endianness>(read_iter, cv.size() - 1, test_val_container) ==
+                nil::marshalling::status_type::not_enough_data);
+}
+
+template<class T>
+void test_indexed_round_trip() {
+    for (std::size_t count : {0, 1, 63, 1000}) {
+        test_indexed_round_trip<nil::marshalling::endian::big_endian, T>(count);
+        test_indexed_round_trip<nil::marshalling::endian::little_endian, T>(count);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(indexed_test_suite)
+
+BOOST_AUTO_TEST_CASE(indexed_cpp_int) {
+    test_indexed_round_trip<boost::multiprecision::cpp_int>();
+}
+
+BOOST_AUTO_TEST_CASE(indexed_cpp_uint512) {
+    test_indexed_round_trip<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -32,6 +32,9 @@
 #include <boost/random/uniform_int.hpp>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 #include <nil/marshalling/status_type.hpp>
 #include <nil/marshalling/field_type.hpp>
@@ -43,6 +46,8 @@
 #include <nil/marshalling/algorithms/pack.hpp>
 
 #include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/options.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
 
 template<class T>
 T generate_random() {
@@ -99,6 +104,13 @@ void test_round_trip_fixed_precision_big_endian(T val) {
 
     BOOST_CHECK(std::equal(test_cv.begin(), test_cv.end(), cv.begin()));
     BOOST_CHECK(status == nil::marshalling::status_type::success);
+
+    if constexpr (!std::is_same_v<unit_type, bool>) {
+        std::array<std::uint8_t, serialized_length<T>::value> static_cv =
+            pack<nil::marshalling::option::big_endian>(val);
+
+        BOOST_CHECK(std::equal(static_cv.begin(), static_cv.end(), cv.begin(), cv.end()));
+    }
 }
 
 template<class T, typename OutputType>
@@ -125,6 +137,13 @@ void test_round_trip_fixed_precision_little_endian(T val) {
 
     BOOST_CHECK(std::equal(test_cv.begin(), test_cv.end(), cv.begin()));
     BOOST_CHECK(status == nil::marshalling::status_type::success);
+
+    if constexpr (!std::is_same_v<unit_type, bool>) {
+        std::array<std::uint8_t, serialized_length<T>::value> static_cv =
+            pack<nil::marshalling::option::little_endian>(val);
+
+        BOOST_CHECK(std::equal(static_cv.begin(), static_cv.end(), cv.begin(), cv.end()));
+    }
 }
 
 template<class T, typename OutputType>
@@ -192,6 +211,130 @@ void test_round_trip_non_fixed_precision() {
     }
 }
 
+template<typename TEndianness, class T, typename OutputType>
+void test_fixed_precision_zero() {
+    using namespace nil::crypto3::marshalling;
+    std::size_t units_bits = std::is_same_v<OutputType, bool> ? 1 : 8 * sizeof(OutputType);
+    using integral_type = types::integral<nil::marshalling::field_type<TEndianness>, T>;
+    std::size_t unitblob_size =
+        integral_type::bit_length() / units_bits + ((integral_type::bit_length() % units_bits) ? 1 : 0);
+
+    T val = 0;
+
+    nil::marshalling::status_type status;
+    std::vector<OutputType> test_cv = nil::marshalling::pack<TEndianness>(val, status);
+
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(test_cv.size(), unitblob_size);
+    BOOST_CHECK(std::all_of(test_cv.begin(), test_cv.end(), [](OutputType unit) { return unit == 0; }));
+
+    T test_val = nil::marshalling::pack<TEndianness>(test_cv, status);
+
+    BOOST_CHECK(val == test_val);
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+}
+
+template<class T, typename OutputType>
+void test_fixed_precision_zero() {
+    test_fixed_precision_zero<nil::marshalling::option::big_endian, T, OutputType>();
+    test_fixed_precision_zero<nil::marshalling::option::little_endian, T, OutputType>();
+}
+
+template<typename TEndianness, class T>
+void test_cached_encoding() {
+    using namespace nil::crypto3::marshalling;
+    using field_base_type = nil::marshalling::field_type<TEndianness>;
+    using plain_type = types::integral<field_base_type, T>;
+    using cached_type = types::integral<field_base_type, T, option::cached_encoding>;
+
+    static_assert(cached_type::has_cached_encoding);
+    static_assert(!plain_type::has_cached_encoding);
+
+    for (unsigned i = 0; i < 100; ++i) {
+        plain_type plain(generate_random<T>());
+        cached_type cached(plain.value());
+
+        std::vector<unsigned char> expected(plain_type::length());
+        auto expected_iter = expected.begin();
+        BOOST_CHECK(plain.write(expected_iter, expected.size()) == nil::marshalling::status_type::success);
+
+        // The second write is served from the cache
+        for (unsigned j = 0; j < 2; ++j) {
+            std::vector<unsigned char> cv(cached_type::length());
+            auto iter = cv.begin();
+            BOOST_CHECK(cached.write(iter, cv.size()) == nil::marshalling::status_type::success);
+            BOOST_CHECK(iter == cv.end());
+            BOOST_CHECK(cv == expected);
+        }
+
+        auto encoded = cached.encoded();
+        BOOST_CHECK(encoded == cached.encoded());
+        BOOST_CHECK(std::equal(encoded->begin(), encoded->end(), expected.begin(), expected.end()));
+
+        std::vector<unsigned char> cv(cached_type::length() - 1);
+        auto iter = cv.begin();
+        BOOST_CHECK(cached.write(iter, cv.size()) == nil::marshalling::status_type::buffer_overflow);
+
+        // Mutable access drops the cache, the buffer handed out before stays intact
+        plain.value() = generate_random<T>();
+        cached.value() = plain.value();
+
+        std::vector<unsigned char> updated(plain_type::length());
+        auto updated_iter = updated.begin();
+        plain.write_no_status(updated_iter);
+
+        BOOST_CHECK(encoded != cached.encoded());
+        BOOST_CHECK(std::equal(cached.encoded()->begin(), cached.encoded()->end(), updated.begin(), updated.end()));
+        BOOST_CHECK(std::equal(encoded->begin(), encoded->end(), expected.begin(), expected.end()));
+
+        // So does reading
+        auto read_iter = expected.cbegin();
+        BOOST_CHECK(cached.read(read_iter, expected.size()) == nil::marshalling::status_type::success);
+        BOOST_CHECK(*cached.encoded() == expected);
+    }
+}
+
+template<typename TEndianness, class T>
+void test_cached_encoding_concurrent() {
+    using namespace nil::crypto3::marshalling;
+    using field_base_type = nil::marshalling::field_type<TEndianness>;
+    using plain_type = types::integral<field_base_type, T>;
+    using cached_type = types::integral<field_base_type, T, option::cached_encoding>;
+
+    constexpr std::size_t threads_count = 8;
+
+    for (unsigned i = 0; i < 20; ++i) {
+        plain_type plain(generate_random<T>());
+        const cached_type cached(plain.value());
+
+        std::vector<unsigned char> expected(plain_type::length());
+        auto expected_iter = expected.begin();
+        plain.write_no_status(expected_iter);
+
+        // Racing first calls all get the encoding that has been published first
+        std::vector<typename cached_type::encoded_buffer_type> encoded(threads_count);
+        std::vector<std::vector<unsigned char>> written(threads_count,
+                                                        std::vector<unsigned char>(cached_type::length()));
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < threads_count; ++t) {
+            threads.emplace_back([&, t]() {
+                auto iter = written[t].begin();
+                cached.write_no_status(iter);
+                encoded[t] = cached.encoded();
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+
+        for (std::size_t t = 0; t < threads_count; ++t) {
+            BOOST_CHECK(encoded[t] == cached.encoded());
+            BOOST_CHECK(written[t] == expected);
+        }
+        BOOST_CHECK(*cached.encoded() == expected);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE(integral_test_suite)
 
 BOOST_AUTO_TEST_CASE(integral_checked_int1024) {
@@ -210,6 +353,11 @@ BOOST_AUTO_TEST_CASE(integral_cpp_int_backend_23) {
     test_round_trip_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>, unsigned char>();
 }
 
+BOOST_AUTO_TEST_CASE(integral_zero) {
+    test_fixed_precision_zero<boost::multiprecision::uint512_modular_t, unsigned char>();
+    test_fixed_precision_zero<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>, unsigned char>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -231,4 +379,31 @@ BOOST_AUTO_TEST_CASE(integral_cpp_int_backend_23_bits) {
     test_round_trip_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>, bool>();
 }
 
+BOOST_AUTO_TEST_CASE(integral_zero_bits) {
+    test_fixed_precision_zero<boost::multiprecision::uint512_modular_t, bool>();
+    test_fixed_precision_zero<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>, bool>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE(integral_cached_encoding_test_suite)
+
+BOOST_AUTO_TEST_CASE(integral_cached_encoding_cpp_uint512) {
+    test_cached_encoding<nil::marshalling::option::big_endian, boost::multiprecision::uint512_modular_t>();
+    test_cached_encoding<nil::marshalling::option::little_endian, boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(integral_cached_encoding_concurrent_cpp_uint512) {
+    test_cached_encoding_concurrent<nil::marshalling::option::big_endian, boost::multiprecision::uint512_modular_t>();
+    test_cached_encoding_concurrent<nil::marshalling::option::little_endian,
+                                    boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(integral_cached_encoding_cpp_int_backend_64) {
+    using T = boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>;
+    test_cached_encoding<nil::marshalling::option::big_endian, T>();
+    test_cached_encoding<nil::marshalling::option::little_endian, T>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,7 @@
 #include <boost/random/uniform_int.hpp>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 #include <type_traits>
 
 #include <nil/marshalling/status_type.hpp>
@@ -45,6 +46,8 @@
 #include <nil/marshalling/algorithms/pack.hpp>
 
 #include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/update.hpp>
 
 template<class T>
 T generate_random() {
@@ -115,6 +118,13 @@ void test_round_trip_fixed_size_container_fixed_precision_big_endian(
 
     BOOST_CHECK(std::equal(test_cv.begin(), test_cv.end(), cv.begin()));
     BOOST_CHECK(status == nil::marshalling::status_type::success);
+
+    if constexpr (!std::is_same_v<unit_type, bool>) {
+        std::array<std::uint8_t, serialized_length<std::array<T, TSize>>::value> static_cv;
+        pack<nil::marshalling::option::big_endian>(val_container, static_cv);
+
+        BOOST_CHECK(std::equal(static_cv.begin(), static_cv.end(), cv.begin(), cv.end()));
+    }
 }
 
 template<class T, std::size_t TSize, typename OutputType>
@@ -153,6 +163,56 @@ void test_round_trip_fixed_size_container_fixed_precision_little_endian(
 
     BOOST_CHECK(std::equal(test_cv.begin(), test_cv.end(), cv.begin()));
     BOOST_CHECK(status == nil::marshalling::status_type::success);
+
+    if constexpr (!std::is_same_v<unit_type, bool>) {
+        std::array<std::uint8_t, serialized_length<std::array<T, TSize>>::value> static_cv;
+        pack<nil::marshalling::option::little_endian>(val_container, static_cv);
+
+        BOOST_CHECK(std::equal(static_cv.begin(), static_cv.end(), cv.begin(), cv.end()));
+    }
+}
+
+template<typename Endianness, class T, std::size_t TSize>
+void test_update_fixed_size_container_fixed_precision(std::array<T, TSize> val_container) {
+    using namespace nil::crypto3::marshalling;
+
+    std::array<std::uint8_t, serialized_length<std::array<T, TSize>>::value> cv;
+    pack<Endianness>(val_container, cv);
+
+    val_container[TSize - 1] = generate_random<T>();
+    BOOST_CHECK(update_element<Endianness>(cv.begin(), cv.size(), TSize - 1, val_container[TSize - 1]) ==
+                nil::marshalling::status_type::success);
+
+    std::vector<std::size_t> indices;
+    std::vector<T> values;
+    for (std::size_t i = 0; i < TSize; i += 7) {
+        val_container[i] = generate_random<T>();
+        indices.push_back(i);
+        values.push_back(val_container[i]);
+    }
+    BOOST_CHECK(update_elements<Endianness>(cv.data(), cv.size(), indices.begin(), indices.end(), values.begin()) ==
+                nil::marshalling::status_type::success);
+
+    BOOST_CHECK(cv == pack<Endianness>(val_container));
+
+    indices.push_back(TSize);
+    values.push_back(generate_random<T>());
+    BOOST_CHECK(update_element<Endianness>(cv.begin(), cv.size(), TSize, values.back()) ==
+                nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(update_elements<Endianness>(cv.data(), cv.size(), indices.begin(), indices.end(), values.begin()) ==
+                nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(cv == pack<Endianness>(val_container));
+
+    // Offsets of such indices wrap around
+    constexpr std::size_t wrapping_index = std::numeric_limits<std::size_t>::max() / serialized_length<T>::value + 1;
+    for (std::size_t index : {std::numeric_limits<std::size_t>::max(), wrapping_index}) {
+        BOOST_CHECK(update_element<Endianness>(cv.begin(), cv.size(), index, values.back()) ==
+                    nil::marshalling::status_type::invalid_msg_data);
+        indices.back() = index;
+        BOOST_CHECK(update_elements<Endianness>(cv.data(), cv.size(), indices.begin(), indices.end(),
+                                                values.begin()) == nil::marshalling::status_type::invalid_msg_data);
+    }
+    BOOST_CHECK(cv == pack<Endianness>(val_container));
 }
 
 template<class T, std::size_t TSize, typename OutputType>
@@ -166,6 +226,14 @@ void test_round_trip_fixed_size_container_fixed_precision() {
         }
         test_round_trip_fixed_size_container_fixed_precision_big_endian<T, TSize, OutputType>(val_container);
         test_round_trip_fixed_size_container_fixed_precision_little_endian<T, TSize, OutputType>(val_container);
+        if constexpr (!std::is_same_v<OutputType, bool>) {
+            if (!(i % 16)) {
+                test_update_fixed_size_container_fixed_precision<nil::marshalling::option::big_endian, T, TSize>(
+                    val_container);
+                test_update_fixed_size_container_fixed_precision<nil::marshalling::option::little_endian, T, TSize>(
+                    val_container);
+            }
+        }
     }
 }
 
@@ -0,0 +1,133 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_integral_gmp_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral_gmp.hpp>
+
+#include <nil/marshalling/algorithms/pack.hpp>
+
+using gmp_number_type = boost::multiprecision::mpz_int;
+
+gmp_number_type generate_random() {
+    static boost::random::uniform_int_distribution<unsigned> ui(0, 40);
+    static boost::random::mt19937 gen;
+    gmp_number_type val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    return val;
+}
+
+// Reference encoding built with plain arithmetic, independent of mpz_export
+template<typename TEndianness>
+std::vector<unsigned char> reference_bytes(gmp_number_type val) {
+    std::vector<unsigned char> result;
+    do {
+        result.push_back(static_cast<unsigned char>(static_cast<unsigned>(val & 0xFF)));
+        val >>= 8;
+    } while (val != 0);
+    if (std::is_same<TEndianness, nil::marshalling::option::big_endian>::value) {
+        std::reverse(result.begin(), result.end());
+    }
+    return result;
+}
+
+template<typename TEndianness>
+void test_round_trip_gmp(const gmp_number_type &val) {
+    using namespace nil::crypto3::marshalling;
+    using integral_type = types::integral<nil::marshalling::field_type<TEndianness>, gmp_number_type>;
+
+    std::vector<unsigned char> cv = reference_bytes<TEndianness>(val);
+
+    BOOST_CHECK_EQUAL(integral_type(val).length(), cv.size());
+
+    nil::marshalling::status_type status;
+    gmp_number_type test_val = nil::marshalling::pack<TEndianness>(cv, status);
+
+    BOOST_CHECK(val == test_val);
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+
+    std::vector<unsigned char> test_cv = nil::marshalling::pack<TEndianness>(val, status);
+
+    BOOST_CHECK(test_cv == cv);
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+}
+
+template<typename TEndianness>
+void test_round_trip_gmp_bits(const gmp_number_type &val) {
+    nil::marshalling::status_type status;
+    std::vector<bool> test_cv = nil::marshalling::pack<TEndianness>(val, status);
+
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(test_cv.size(), mpz_sizeinbase(val.backend().data(), 2));
+
+    gmp_number_type test_val = nil::marshalling::pack<TEndianness>(test_cv, status);
+
+    BOOST_CHECK(val == test_val);
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+}
+
+BOOST_AUTO_TEST_SUITE(integral_gmp_test_suite)
+
+BOOST_AUTO_TEST_CASE(integral_gmp_zero) {
+    test_round_trip_gmp<nil::marshalling::option::big_endian>(gmp_number_type(0));
+    test_round_trip_gmp<nil::marshalling::option::little_endian>(gmp_number_type(0));
+}
+
+BOOST_AUTO_TEST_CASE(integral_gmp_random) {
+    for (unsigned i = 0; i < 1000; ++i) {
+        gmp_number_type val = generate_random();
+        test_round_trip_gmp<nil::marshalling::option::big_endian>(val);
+        test_round_trip_gmp<nil::marshalling::option::little_endian>(val);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(integral_gmp_random_bits) {
+    for (unsigned i = 0; i < 100; ++i) {
+        gmp_number_type val = generate_random();
+        test_round_trip_gmp_bits<nil::marshalling::option::big_endian>(val);
+        test_round_trip_gmp_bits<nil::marshalling::option::little_endian>(val);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
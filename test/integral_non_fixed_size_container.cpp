@@ -33,9 +33,11 @@
 #include <iomanip>
 
 #include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
 #include <nil/marshalling/endianness.hpp>
 
 #include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
 #include <boost/multiprecision/number.hpp>
 
 #include <nil/marshalling/algorithms/pack.hpp>
@@ -84,6 +86,10 @@ void test_round_trip_non_fixed_size_container_fixed_precision(std::vector<T>
 
     BOOST_CHECK(status == nil::marshalling::status_type::success);
 
+    if constexpr (!std::is_same_v<unit_type, bool>) {
+        BOOST_CHECK_EQUAL(types::total_length(val_container), cv.size());
+    }
+
     std::vector<T> test_val = nil::marshalling::pack<Endianness>(cv, status);
 
     BOOST_CHECK(std::equal(val_container.begin(), val_container.end(), test_val.begin()));
@@ -107,6 +113,64 @@ void test_round_trip_non_fixed_size_container_fixed_precision() {
     }
 }
 
+template<typename Endianness, class T>
+void test_non_fixed_precision_length() {
+    using namespace nil::crypto3::marshalling;
+    using integral_type = types::integral<nil::marshalling::field_type<Endianness>, T>;
+
+    constexpr bool big_endian = std::is_same<Endianness, nil::marshalling::option::big_endian>::value;
+
+    // Zero is still written as a single unit
+    integral_type field;
+    BOOST_CHECK_EQUAL(field.length(), 1);
+    BOOST_CHECK_EQUAL(field.bit_length(), 1);
+
+    for (unsigned i = 0; i < 1000; ++i) {
+        T val = generate_random<T>();
+        std::vector<std::uint8_t> cv;
+        export_bits(val, std::back_inserter(cv), 8, big_endian);
+
+        // Lengths follow the value modified in place
+        field.value() = val;
+        BOOST_CHECK_EQUAL(field.length(), cv.size());
+        BOOST_CHECK_EQUAL(field.bit_length(), val == 0 ? 1 : boost::multiprecision::msb(val) + 1);
+
+        field.value() = 0;
+        BOOST_CHECK_EQUAL(field.length(), 1);
+        BOOST_CHECK_EQUAL(field.bit_length(), 1);
+
+        // And the read one
+        integral_type read_field;
+        auto read_iter = cv.cbegin();
+        BOOST_CHECK(read_field.read(read_iter, cv.size()) == nil::marshalling::status_type::success);
+        BOOST_CHECK(read_field.value() == val);
+        BOOST_CHECK_EQUAL(read_field.length(), cv.size());
+        BOOST_CHECK_EQUAL(read_field.bit_length(), val == 0 ? 1 : boost::multiprecision::msb(val) + 1);
+    }
+
+    std::vector<T> val_container;
+    std::size_t expected_length = 0;
+    for (std::size_t bits : {0, 1, 8, 9, 64, 65, 255, 256, 1000}) {
+        T val = bits ? (T(1) << (bits - 1)) : T(0);
+        val_container.push_back(val);
+        expected_length += integral_type(val).length();
+        BOOST_CHECK_EQUAL(integral_type(val).length(), bits ? (bits + 7) / 8 : 1);
+    }
+    BOOST_CHECK_EQUAL(types::total_length(val_container), expected_length);
+}
+
+BOOST_AUTO_TEST_SUITE(integral_non_fixed_precision_length_test_suite)
+
+BOOST_AUTO_TEST_CASE(integral_non_fixed_precision_length_cpp_int_be) {
+    test_non_fixed_precision_length<nil::marshalling::option::big_endian, boost::multiprecision::cpp_int>();
+}
+
+BOOST_AUTO_TEST_CASE(integral_non_fixed_precision_length_cpp_int_le) {
+    test_non_fixed_precision_length<nil::marshalling::option::little_endian, boost::multiprecision::cpp_int>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE(integral_non_fixed_test_suite)
 
 BOOST_AUTO_TEST_CASE(integral_non_fixed_checked_int1024_be) {
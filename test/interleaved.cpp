@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_interleaved_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/marshalling/algorithms/pack.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/interleaved.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<class T, std::size_t TSize>
+void test_round_trip_interleaved() {
+    using namespace nil::crypto3::marshalling;
+
+    constexpr std::size_t words_count = processing::interleaved_words_count<T>();
+    constexpr std::size_t word_size = sizeof(processing::interleaved_word_type);
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < TSize; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+
+    std::vector<std::uint8_t> cv(processing::interleaved_length<T>(TSize));
+    auto write_iter = cv.begin();
+    processing::write_interleaved<nil::marshalling::endian::little_endian>(val_container.begin(),
+                                                                          val_container.end(), write_iter);
+    BOOST_CHECK(write_iter == cv.end());
+
+    // Word w of element i is stored at position w * TSize + i
+    nil::marshalling::status_type status;
+    for (std::size_t i = 0; i < TSize; i++) {
+        std::vector<std::uint8_t> element_cv =
+            nil::marshalling::pack<nil::marshalling::option::little_endian>(val_container[i], status);
+        element_cv.resize(words_count * word_size, 0x00);
+
+        for (std::size_t w = 0; w < words_count; w++) {
+            BOOST_CHECK(std::equal(element_cv.begin() + w * word_size, element_cv.begin() + (w + 1) * word_size,
+                                   cv.begin() + (w * TSize + i) * word_size));
+        }
+    }
+
+    std::vector<T> test_val(TSize);
+    auto read_iter = cv.cbegin();
+    status = processing::read_interleaved<nil::marshalling::endian::little_endian>(read_iter, cv.size(),
+                                                                                 test_val.begin(), test_val.end());
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+    BOOST_CHECK(read_iter == cv.cend());
+    BOOST_CHECK(val_container == test_val);
+
+    read_iter = cv.cbegin();
+    status = processing::read_interleaved<nil::marshalling::endian::little_endian>(read_iter, cv.size() - 1,
+                                                                                 test_val.begin(), test_val.end());
+    BOOST_CHECK(status == nil::marshalling::status_type::not_enough_data);
+
+    write_iter = cv.begin();
+    processing::write_interleaved<nil::marshalling::endian::big_endian>(val_container.begin(),
+                                                                       val_container.end(), write_iter);
+    read_iter = cv.cbegin();
+    status = processing::read_interleaved<nil::marshalling::endian::big_endian>(read_iter, cv.size(),
+                                                                              test_val.begin(), test_val.end());
+    BOOST_CHECK(status == nil::marshalling::status_type::success);
+    BOOST_CHECK(val_container == test_val);
+}
+
+BOOST_AUTO_TEST_SUITE(interleaved_test_suite)
+
+BOOST_AUTO_TEST_CASE(interleaved_cpp_uint512) {
+    test_round_trip_interleaved<boost::multiprecision::uint512_modular_t, 128>();
+}
+
+BOOST_AUTO_TEST_CASE(interleaved_cpp_int_backend_381) {
+    test_round_trip_interleaved<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<381>>, 33>();
+}
+
+BOOST_AUTO_TEST_CASE(interleaved_cpp_int_backend_23) {
+    test_round_trip_interleaved<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>, 17>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
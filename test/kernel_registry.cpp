@@ -0,0 +1,256 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_kernel_registry_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/kernel_registry.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/context.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<class T>
+std::uint8_t *write_nothing_kernel(const T *, const T *, std::uint8_t *out) {
+    return out;
+}
+
+std::size_t counted_calls = 0;
+
+template<typename Endianness, class T>
+std::uint8_t *write_counting_kernel(const T *first, const T *last, std::uint8_t *out) {
+    ++counted_calls;
+    return nil::crypto3::marshalling::processing::detail::write_generic_kernel<Endianness>(first, last, out);
+}
+
+template<typename Endianness, class T>
+const std::uint8_t *read_counting_kernel(const std::uint8_t *in, T *first, T *last) {
+    ++counted_calls;
+    return nil::crypto3::marshalling::processing::detail::read_generic_kernel<Endianness>(in, first, last);
+}
+
+template<typename TEndianOption, typename Endianness, class T>
+void test_kernel_registry() {
+    using namespace nil::crypto3::marshalling;
+    using integral_type = types::integral<nil::marshalling::field_type<TEndianOption>, T>;
+    using registry_type = processing::write_kernel_registry<T, Endianness>;
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < 256; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+    val_container.push_back(T(0));
+
+    std::size_t value_length = integral_type::max_length();
+    std::vector<std::uint8_t> cv(value_length * val_container.size());
+    auto write_iter = cv.begin();
+    for (const T &val : val_container) {
+        integral_type(val).write(write_iter, value_length);
+    }
+
+    registry_type &registry = registry_type::instance();
+    std::string default_kernel_name = registry.kernel_name();
+
+    std::vector<typename registry_type::kernel_info> kernels = registry.supported_kernels();
+    BOOST_CHECK(!kernels.empty());
+    for (const typename registry_type::kernel_info &info : kernels) {
+        BOOST_CHECK(registry.pin(info.name));
+        BOOST_CHECK_EQUAL(registry.kernel_name(), info.name);
+
+        std::vector<std::uint8_t> test_cv(cv.size());
+        std::uint8_t *end =
+            registry.write(val_container.data(), val_container.data() + val_container.size(), test_cv.data());
+        BOOST_CHECK(end == test_cv.data() + test_cv.size());
+        BOOST_CHECK(test_cv == cv);
+    }
+
+    BOOST_CHECK(!registry.pin("no_such_kernel"));
+
+    registry.calibrate(64, 2);
+    BOOST_CHECK(std::any_of(kernels.begin(), kernels.end(), [&](const typename registry_type::kernel_info &info) {
+        return info.kernel == registry.kernel();
+    }));
+
+    registry.add({"nothing", &processing::detail::always_supported, &write_nothing_kernel<T>});
+    BOOST_CHECK(registry.pin("nothing"));
+    BOOST_CHECK_EQUAL(registry.kernel_name(), "nothing");
+
+    BOOST_CHECK(registry.pin(default_kernel_name));
+}
+
+template<typename TEndianOption, typename Endianness, class T>
+void test_read_kernel_registry() {
+    using namespace nil::crypto3::marshalling;
+    using integral_type = types::integral<nil::marshalling::field_type<TEndianOption>, T>;
+    using registry_type = processing::read_kernel_registry<T, Endianness>;
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < 256; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+    val_container.push_back(T(0));
+
+    std::size_t value_length = integral_type::max_length();
+    std::vector<std::uint8_t> cv(value_length * val_container.size());
+    processing::detail::write_generic_kernel<Endianness>(val_container.data(),
+                                                         val_container.data() + val_container.size(), cv.data());
+
+    registry_type &registry = registry_type::instance();
+    std::string default_kernel_name = registry.kernel_name();
+
+    std::vector<typename registry_type::kernel_info> kernels = registry.supported_kernels();
+    BOOST_CHECK(!kernels.empty());
+    for (const typename registry_type::kernel_info &info : kernels) {
+        BOOST_CHECK(registry.pin(info.name));
+        BOOST_CHECK_EQUAL(registry.kernel_name(), info.name);
+
+        std::vector<T> test_val_container(val_container.size(), ~T(0));
+        const std::uint8_t *end =
+            registry.read(cv.data(), test_val_container.data(), test_val_container.data() + test_val_container.size());
+        BOOST_CHECK(end == cv.data() + cv.size());
+        BOOST_CHECK(test_val_container == val_container);
+    }
+
+    registry.calibrate(64, 2);
+    BOOST_CHECK(std::any_of(kernels.begin(), kernels.end(), [&](const typename registry_type::kernel_info &info) {
+        return info.kernel == registry.kernel();
+    }));
+    BOOST_CHECK(registry.pin(default_kernel_name));
+}
+
+template<typename TEndianOption, typename Endianness, class T>
+void test_kernel_dispatch() {
+    using namespace nil::crypto3::marshalling;
+    using integral_type = types::integral<nil::marshalling::field_type<TEndianOption>, T>;
+    using write_registry_type = processing::write_kernel_registry<T, Endianness>;
+    using read_registry_type = processing::read_kernel_registry<T, Endianness>;
+
+    static_assert(processing::is_kernel_dispatched<T, std::vector<std::uint8_t>::iterator>::value);
+    static_assert(!processing::is_kernel_dispatched<T, std::vector<bool>::iterator>::value);
+
+    write_registry_type &write_registry = write_registry_type::instance();
+    read_registry_type &read_registry = read_registry_type::instance();
+    std::string write_kernel_name = write_registry.kernel_name();
+    std::string read_kernel_name = read_registry.kernel_name();
+
+    write_registry.add({"counting", &processing::detail::always_supported, &write_counting_kernel<Endianness, T>});
+    read_registry.add({"counting", &processing::detail::always_supported, &read_counting_kernel<Endianness, T>});
+    BOOST_CHECK(write_registry.pin("counting"));
+    BOOST_CHECK(read_registry.pin("counting"));
+
+    // Single fields keep the inline limb conversion
+    T val = generate_random<T>();
+    std::vector<std::uint8_t> cv(integral_type::max_length());
+    counted_calls = 0;
+    auto write_iter = cv.begin();
+    BOOST_CHECK(integral_type(val).write(write_iter, cv.size()) == nil::marshalling::status_type::success);
+    integral_type field;
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(field.read(read_iter, cv.size()) == nil::marshalling::status_type::success);
+    BOOST_CHECK(field.value() == val);
+    BOOST_CHECK_EQUAL(counted_calls, 0);
+
+    // A run of values takes a single kernel call in each direction
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < 64; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+    serialization_context<TEndianOption, T> context;
+    const std::vector<std::uint8_t> &buffer = context.encode(val_container);
+    BOOST_CHECK_EQUAL(counted_calls, 1);
+
+    std::vector<T> test_val_container;
+    auto buffer_iter = buffer.cbegin();
+    BOOST_CHECK(context.decode(buffer_iter, buffer.size(), test_val_container) ==
+                nil::marshalling::status_type::success);
+    BOOST_CHECK_EQUAL(counted_calls, 2);
+    BOOST_CHECK(test_val_container == val_container);
+    BOOST_CHECK(buffer_iter == buffer.cend());
+
+    // Non byte units don't
+    std::vector<bool> bits(integral_type::bit_length() * val_container.size());
+    auto bits_iter = bits.begin();
+    detail::pack_range_into<TEndianOption>(val_container.data(),
+                                           val_container.data() + val_container.size(), bits_iter);
+    BOOST_CHECK_EQUAL(counted_calls, 2);
+
+    BOOST_CHECK(write_registry.pin(write_kernel_name));
+    BOOST_CHECK(read_registry.pin(read_kernel_name));
+}
+
+BOOST_AUTO_TEST_SUITE(kernel_registry_test_suite)
+
+BOOST_AUTO_TEST_CASE(kernel_registry_cpp_uint512) {
+    using T = boost::multiprecision::uint512_modular_t;
+    test_kernel_registry<nil::marshalling::option::big_endian, nil::marshalling::endian::big_endian, T>();
+    test_kernel_registry<nil::marshalling::option::little_endian, nil::marshalling::endian::little_endian, T>();
+    test_read_kernel_registry<nil::marshalling::option::big_endian, nil::marshalling::endian::big_endian, T>();
+    test_read_kernel_registry<nil::marshalling::option::little_endian, nil::marshalling::endian::little_endian, T>();
+    test_kernel_dispatch<nil::marshalling::option::big_endian, nil::marshalling::endian::big_endian, T>();
+    test_kernel_dispatch<nil::marshalling::option::little_endian, nil::marshalling::endian::little_endian, T>();
+}
+
+BOOST_AUTO_TEST_CASE(kernel_registry_cpp_int_backend_23) {
+    using T = boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>;
+    test_kernel_registry<nil::marshalling::option::big_endian, nil::marshalling::endian::big_endian, T>();
+    test_kernel_registry<nil::marshalling::option::little_endian, nil::marshalling::endian::little_endian, T>();
+    test_read_kernel_registry<nil::marshalling::option::big_endian, nil::marshalling::endian::big_endian, T>();
+    test_read_kernel_registry<nil::marshalling::option::little_endian, nil::marshalling::endian::little_endian, T>();
+    test_kernel_dispatch<nil::marshalling::option::big_endian, nil::marshalling::endian::big_endian, T>();
+    test_kernel_dispatch<nil::marshalling::option::little_endian, nil::marshalling::endian::little_endian, T>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
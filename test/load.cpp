@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_load_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/load.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+std::string write_temp_file(const std::vector<std::uint8_t> &cv) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "crypto3_marshalling_load_test.bin";
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char *>(cv.data()), static_cast<std::streamsize>(cv.size()));
+    return path.string();
+}
+
+template<typename Endianness, class T>
+void test_load_fixed_precision() {
+    using namespace nil::crypto3::marshalling;
+
+    constexpr std::size_t value_length = serialized_length<T>::value;
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < 1000; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+    std::vector<std::uint8_t> cv(val_container.size() * value_length);
+    auto write_iter = cv.begin();
+    for (const T &val : val_container) {
+        detail::pack_into<Endianness>(val, write_iter);
+    }
+    std::string path = write_temp_file(cv);
+
+    // Blocks smaller, equal and not a multiple of the value length, rings shorter and longer
+    // than the number of blocks
+    for (std::size_t block_size :
+         {std::size_t(1), value_length, 7 * value_length + 3, default_load_block_size}) {
+        for (std::size_t ring_size : {std::size_t(1), std::size_t(3), default_load_ring_size, std::size_t(10000)}) {
+            for (std::size_t threads_count : {std::size_t(1), std::size_t(4)}) {
+                std::vector<T> test_val_container;
+                BOOST_CHECK(load_file<Endianness>(path, test_val_container, block_size, ring_size,
+                                                  threads_count) == nil::marshalling::status_type::success);
+                BOOST_CHECK(test_val_container == val_container);
+            }
+        }
+    }
+
+    // A file cut in the middle of a value is rejected
+    cv.pop_back();
+    path = write_temp_file(cv);
+    std::vector<T> test_val_container = val_container;
+    BOOST_CHECK(load_file<Endianness>(path, test_val_container) == nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(test_val_container == val_container);
+
+    // Empty file gives an empty vector
+    path = write_temp_file(std::vector<std::uint8_t>());
+    BOOST_CHECK(load_file<Endianness>(path, test_val_container) == nil::marshalling::status_type::success);
+    BOOST_CHECK(test_val_container.empty());
+
+    std::remove(path.c_str());
+    test_val_container = val_container;
+    BOOST_CHECK(load_file<Endianness>(path, test_val_container) == nil::marshalling::status_type::not_enough_data);
+    BOOST_CHECK(test_val_container == val_container);
+}
+
+template<class T>
+void test_load_fixed_precision() {
+    test_load_fixed_precision<nil::marshalling::option::big_endian, T>();
+    test_load_fixed_precision<nil::marshalling::option::little_endian, T>();
+}
+
+BOOST_AUTO_TEST_SUITE(load_test_suite)
+
+BOOST_AUTO_TEST_CASE(load_cpp_uint512) {
+    test_load_fixed_precision<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(load_cpp_int_backend_64) {
+    test_load_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_non_temporal_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/non_temporal.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<typename TEndianOption, typename Endianness, class T>
+void test_non_temporal(const std::vector<T> &val_container) {
+    using namespace nil::crypto3::marshalling;
+    using integral_type = types::integral<nil::marshalling::field_type<TEndianOption>, T>;
+
+    std::size_t value_length = integral_type::max_length();
+    std::vector<std::uint8_t> cv(value_length * val_container.size());
+    auto write_iter = cv.begin();
+    for (const T &val : val_container) {
+        integral_type(val).write(write_iter, value_length);
+    }
+
+    for (std::size_t threshold : {std::size_t(0), processing::default_non_temporal_threshold}) {
+        // Misaligned outputs exercise the regular stores before the first cache line boundary
+        for (std::size_t offset = 0; offset < 4; offset++) {
+            std::vector<std::uint8_t> test_cv(cv.size() + offset + 1, 0xAA);
+            std::uint8_t *end = processing::write_non_temporal<Endianness>(
+                val_container.begin(), val_container.end(), test_cv.data() + offset, threshold);
+
+            BOOST_CHECK(end == test_cv.data() + offset + cv.size());
+            BOOST_CHECK(std::equal(cv.begin(), cv.end(), test_cv.begin() + offset));
+            BOOST_CHECK_EQUAL(test_cv.back(), 0xAA);
+        }
+    }
+}
+
+template<class T>
+void test_non_temporal() {
+    for (std::size_t count : {0, 1, 3, 1000}) {
+        std::vector<T> val_container;
+        for (std::size_t i = 0; i < count; i++) {
+            val_container.push_back(generate_random<T>());
+        }
+        test_non_temporal<nil::marshalling::option::big_endian, nil::marshalling::endian::big_endian>(
+            val_container);
+        test_non_temporal<nil::marshalling::option::little_endian, nil::marshalling::endian::little_endian>(
+            val_container);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(non_temporal_test_suite)
+
+BOOST_AUTO_TEST_CASE(non_temporal_cpp_uint512) {
+    test_non_temporal<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(non_temporal_cpp_int_backend_255) {
+    test_non_temporal<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<255>>>();
+}
+
+BOOST_AUTO_TEST_CASE(non_temporal_cpp_int_backend_23) {
+    test_non_temporal<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,160 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_segmented_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/segmented.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+std::vector<std::vector<std::uint8_t>> split_into_segments(const std::vector<std::uint8_t> &cv,
+                                                           std::size_t segment_size) {
+    std::vector<std::vector<std::uint8_t>> segments;
+    for (std::size_t begin = 0; begin < cv.size(); begin += segment_size) {
+        segments.emplace_back(cv.begin() + begin, cv.begin() + std::min(cv.size(), begin + segment_size));
+        // Empty segments must be skipped transparently
+        segments.emplace_back();
+    }
+    return segments;
+}
+
+template<typename Endianness, class T>
+void test_segmented_fixed_precision(std::size_t segment_size) {
+    using namespace nil::crypto3::marshalling;
+    using integral_type = types::integral<nil::marshalling::field_type<Endianness>, T>;
+
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < 64; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+
+    std::vector<std::uint8_t> cv(serialized_length<T>::value * val_container.size());
+    auto write_iter = cv.begin();
+    for (const T &val : val_container) {
+        BOOST_CHECK(integral_type(val).write(write_iter, serialized_length<T>::value) ==
+                    nil::marshalling::status_type::success);
+    }
+
+    std::vector<std::vector<std::uint8_t>> segments = split_into_segments(cv, segment_size);
+
+    segmented_input<std::vector<std::vector<std::uint8_t>>::const_iterator> input(segments.cbegin(),
+                                                                                   segments.cend());
+    T first_val;
+    BOOST_CHECK(read_segmented<Endianness>(input, first_val) == nil::marshalling::status_type::success);
+    BOOST_CHECK(first_val == val_container[0]);
+
+    std::vector<T> test_val_container(val_container.size() - 1);
+    BOOST_CHECK(read_segmented<Endianness>(input, test_val_container.begin(), test_val_container.end()) ==
+                nil::marshalling::status_type::success);
+    BOOST_CHECK(std::equal(test_val_container.begin(), test_val_container.end(), val_container.begin() + 1));
+    BOOST_CHECK_EQUAL(input.remaining(), 0);
+
+    BOOST_CHECK(read_segmented<Endianness>(input, first_val) == nil::marshalling::status_type::not_enough_data);
+}
+
+template<class T>
+void test_segmented_fixed_precision() {
+    for (std::size_t segment_size : {1, 5, 13, 64, 1500}) {
+        test_segmented_fixed_precision<nil::marshalling::option::big_endian, T>(segment_size);
+        test_segmented_fixed_precision<nil::marshalling::option::little_endian, T>(segment_size);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(segmented_test_suite)
+
+BOOST_AUTO_TEST_CASE(segmented_cpp_uint512) {
+    test_segmented_fixed_precision<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(segmented_cpp_int_backend_23) {
+    test_segmented_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>>();
+}
+
+BOOST_AUTO_TEST_CASE(segmented_cpp_int) {
+    using namespace nil::crypto3::marshalling;
+    using T = boost::multiprecision::cpp_int;
+    using integral_type = types::integral<nil::marshalling::field_type<nil::marshalling::option::big_endian>, T>;
+
+    std::vector<T> val_container;
+    std::vector<std::size_t> lengths;
+    std::vector<std::uint8_t> cv;
+    for (std::size_t i = 0; i < 64; i++) {
+        val_container.push_back(generate_random<T>());
+        integral_type field(val_container.back());
+        lengths.push_back(field.length());
+        cv.resize(cv.size() + field.length());
+        auto write_iter = cv.end() - static_cast<std::ptrdiff_t>(field.length());
+        BOOST_CHECK(field.write(write_iter, field.length()) == nil::marshalling::status_type::success);
+    }
+
+    for (std::size_t segment_size : {1, 7, 4096}) {
+        std::vector<std::vector<std::uint8_t>> segments = split_into_segments(cv, segment_size);
+
+        segmented_input<std::vector<std::vector<std::uint8_t>>::const_iterator> input(segments.cbegin(),
+                                                                                       segments.cend());
+        for (std::size_t i = 0; i < val_container.size(); i++) {
+            T test_val;
+            BOOST_CHECK(read_segmented<nil::marshalling::option::big_endian>(input, lengths[i], test_val) ==
+                        nil::marshalling::status_type::success);
+            BOOST_CHECK(test_val == val_container[i]);
+        }
+        BOOST_CHECK_EQUAL(input.remaining(), 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
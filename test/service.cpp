@@ -0,0 +1,224 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_service_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/context.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/service.hpp>
+#include <nil/crypto3/marshalling/multiprecision/processing/detail/mpmc_queue.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<typename Endianness, class T>
+void test_service_fixed_precision() {
+    using namespace nil::crypto3::marshalling;
+
+    // Small and large vectors mixed, the large ones are split into many sub-tasks
+    std::vector<std::vector<T>> messages;
+    for (std::size_t size : {0, 1, 5, 64, 65, 1000, 3, 4096, 2}) {
+        std::vector<T> val_container;
+        for (std::size_t i = 0; i < size; i++) {
+            val_container.push_back(generate_random<T>());
+        }
+        messages.push_back(val_container);
+    }
+
+    serialization_context<Endianness, T> context;
+    serialization_service service(4, 64, 8);
+    BOOST_CHECK_EQUAL(service.threads_count(), 4);
+
+    // Concurrent producers overflowing the submission queue
+    constexpr std::size_t producers_count = 4;
+    std::vector<std::vector<std::future<std::vector<std::uint8_t>>>> futures(producers_count);
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < producers_count; p++) {
+        producers.emplace_back([&, p]() {
+            for (std::size_t round = 0; round < 8; round++) {
+                for (const std::vector<T> &message : messages) {
+                    futures[p].push_back(service.encode<Endianness>(message));
+                }
+            }
+        });
+    }
+    for (std::thread &producer : producers) {
+        producer.join();
+    }
+    for (std::size_t p = 0; p < producers_count; p++) {
+        for (std::size_t i = 0; i < futures[p].size(); i++) {
+            const std::vector<T> &message = messages[i % messages.size()];
+            std::vector<std::uint8_t> cv = futures[p][i].get();
+            BOOST_CHECK(cv == context.encode(message));
+
+            decode_result<T> result = service.decode<Endianness, T>(cv).get();
+            BOOST_CHECK(result.status == nil::marshalling::status_type::success);
+            BOOST_CHECK(result.values == message);
+        }
+    }
+
+    // Callbacks run on the workers, so only count the outcomes there
+    using context_type = serialization_context<Endianness, T>;
+    std::atomic<std::size_t> completed(0);
+    std::atomic<std::size_t> decoded(0);
+    std::promise<void> all_completed;
+    for (const std::vector<T> &message : messages) {
+        service.encode<Endianness>(message, [&](std::vector<std::uint8_t> cv) {
+            std::vector<T> test_val_container;
+            auto read_iter = cv.cbegin();
+            if (context_type().decode(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::success) {
+                decoded.fetch_add(1);
+            }
+            if (completed.fetch_add(1) + 1 == messages.size()) {
+                all_completed.set_value();
+            }
+        });
+    }
+    all_completed.get_future().wait();
+    BOOST_CHECK_EQUAL(decoded.load(), messages.size());
+
+    // Truncated input
+    std::vector<std::uint8_t> cv = context.encode(messages[5]);
+    for (std::size_t size : {std::size_t(0), sizeof(std::size_t), cv.size() - 1}) {
+        decode_result<T> result =
+            service.decode<Endianness, T>(std::vector<std::uint8_t>(cv.begin(), cv.begin() + size)).get();
+        BOOST_CHECK(result.status == nil::marshalling::status_type::not_enough_data);
+        BOOST_CHECK(result.values.empty());
+    }
+}
+
+template<typename Endianness, class T>
+void test_service_submit_from_callback() {
+    using namespace nil::crypto3::marshalling;
+
+    // Two workers and a queue of two slots, both workers overflow the queue from their callbacks
+    serialization_service service(2, 64, 2);
+
+    constexpr std::size_t nested_count = 64;
+    std::vector<T> message(100, T(3));
+    std::atomic<std::size_t> completed(0);
+    std::atomic<std::size_t> matched(0);
+    std::atomic<std::size_t> arrived(0);
+    std::promise<void> all_completed;
+    std::vector<std::uint8_t> expected = serialization_context<Endianness, T>().encode(message);
+
+    for (std::size_t outer = 0; outer < 2; outer++) {
+        service.encode<Endianness>(message, [&](std::vector<std::uint8_t>) {
+            arrived.fetch_add(1);
+            while (arrived.load() < 2) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < nested_count; i++) {
+                service.encode<Endianness>(message, [&](std::vector<std::uint8_t> cv) {
+                    if (cv == expected) {
+                        matched.fetch_add(1);
+                    }
+                    if (completed.fetch_add(1) + 1 == 2 * nested_count) {
+                        all_completed.set_value();
+                    }
+                });
+            }
+        });
+    }
+    BOOST_REQUIRE(all_completed.get_future().wait_for(std::chrono::seconds(60)) == std::future_status::ready);
+    BOOST_CHECK_EQUAL(matched.load(), 2 * nested_count);
+}
+
+template<class T>
+void test_service_fixed_precision() {
+    test_service_fixed_precision<nil::marshalling::option::big_endian, T>();
+    test_service_fixed_precision<nil::marshalling::option::little_endian, T>();
+}
+
+BOOST_AUTO_TEST_SUITE(service_test_suite)
+
+BOOST_AUTO_TEST_CASE(service_mpmc_queue) {
+    nil::crypto3::marshalling::processing::detail::mpmc_queue<std::size_t> queue(3);
+    BOOST_CHECK_EQUAL(queue.capacity(), 4);
+
+    std::size_t value;
+    BOOST_CHECK(!queue.try_pop(value));
+    for (std::size_t lap = 0; lap < 3; lap++) {
+        for (std::size_t i = 0; i < queue.capacity(); i++) {
+            BOOST_CHECK(queue.try_push(std::size_t(i)));
+        }
+        BOOST_CHECK(!queue.try_push(std::size_t(0)));
+        for (std::size_t i = 0; i < queue.capacity(); i++) {
+            BOOST_CHECK(queue.try_pop(value));
+            BOOST_CHECK_EQUAL(value, i);
+        }
+        BOOST_CHECK(!queue.try_pop(value));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(service_cpp_uint512) {
+    test_service_fixed_precision<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(service_cpp_int_backend_64) {
+    test_service_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>>();
+}
+
+BOOST_AUTO_TEST_CASE(service_submit_from_callback) {
+    test_service_submit_from_callback<nil::marshalling::option::big_endian, boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_sparse_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/types/integral.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/pack.hpp>
+#include <nil/crypto3/marshalling/multiprecision/algorithms/sparse.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<typename Endianness, class T>
+nil::crypto3::marshalling::sparse_mode test_sparse_round_trip(const std::vector<T> &val_container) {
+    using namespace nil::crypto3::marshalling;
+
+    std::vector<std::uint8_t> cv = encode_sparse<Endianness>(val_container);
+    BOOST_CHECK_EQUAL(cv.size(), sparse_length(val_container));
+
+    std::vector<T> test_val_container;
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(read_sparse<Endianness>(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::success);
+    BOOST_CHECK(read_iter == cv.cend());
+    BOOST_CHECK(test_val_container == val_container);
+
+    // Truncated encoding leaves the output untouched
+    for (std::size_t size : {std::size_t(0), std::size_t(8), cv.size() - 1}) {
+        if (size >= cv.size()) {
+            continue;
+        }
+        std::vector<T> untouched = {T(1)};
+        read_iter = cv.cbegin();
+        BOOST_CHECK(read_sparse<Endianness>(read_iter, size, untouched) ==
+                    nil::marshalling::status_type::not_enough_data);
+        BOOST_CHECK(read_iter == cv.cbegin());
+        BOOST_CHECK(untouched.size() == 1);
+    }
+
+    return static_cast<sparse_mode>(cv[0]);
+}
+
+template<typename Endianness, class T>
+void test_sparse_fixed_precision(std::size_t count) {
+    using namespace nil::crypto3::marshalling;
+
+    std::vector<T> val_container(count, T(0));
+    BOOST_CHECK(test_sparse_round_trip<Endianness>(val_container) ==
+                (count ? sparse_mode::bitmap : sparse_mode::dense));
+
+    for (std::size_t i = 0; i < count; i += 17) {
+        val_container[i] = generate_random<T>() + 1;
+    }
+    sparse_mode mode = test_sparse_round_trip<Endianness>(val_container);
+    if (count >= 64) {
+        BOOST_CHECK(mode == sparse_mode::bitmap);
+        BOOST_CHECK_LT(sparse_length(val_container), count * serialized_length<T>::value / 8);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        val_container[i] = generate_random<T>() + 1;
+    }
+    BOOST_CHECK(test_sparse_round_trip<Endianness>(val_container) == sparse_mode::dense);
+    BOOST_CHECK_EQUAL(sparse_length(val_container), 9 + count * serialized_length<T>::value);
+}
+
+template<class T>
+void test_sparse_fixed_precision() {
+    for (std::size_t count : {0, 1, 7, 8, 9, 1000}) {
+        test_sparse_fixed_precision<nil::marshalling::option::big_endian, T>(count);
+        test_sparse_fixed_precision<nil::marshalling::option::little_endian, T>(count);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(sparse_test_suite)
+
+BOOST_AUTO_TEST_CASE(sparse_cpp_uint512) {
+    test_sparse_fixed_precision<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(sparse_cpp_int_backend_64) {
+    test_sparse_fixed_precision<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<64>>>();
+}
+
+BOOST_AUTO_TEST_CASE(sparse_malformed) {
+    using namespace nil::crypto3::marshalling;
+    using T = boost::multiprecision::uint512_modular_t;
+
+    std::vector<T> val_container(10, T(0));
+    val_container[3] = T(5);
+    std::vector<std::uint8_t> cv = encode_sparse<nil::marshalling::option::big_endian>(val_container);
+
+    // Count doesn't match the output range
+    std::vector<T> test_val_container(9, T(0));
+    auto read_iter = cv.cbegin();
+    BOOST_CHECK(read_sparse<nil::marshalling::option::big_endian>(read_iter, cv.size(), test_val_container.begin(),
+                                                                  test_val_container.end()) ==
+                nil::marshalling::status_type::invalid_msg_data);
+
+    // Bits set past the count
+    cv[10] |= 0x80;
+    read_iter = cv.cbegin();
+    BOOST_CHECK(read_sparse<nil::marshalling::option::big_endian>(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::invalid_msg_data);
+
+    // Unknown mode
+    cv[0] = 2;
+    read_iter = cv.cbegin();
+    BOOST_CHECK(read_sparse<nil::marshalling::option::big_endian>(read_iter, cv.size(), test_val_container) ==
+                nil::marshalling::status_type::invalid_msg_data);
+    BOOST_CHECK(read_iter == cv.cbegin());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
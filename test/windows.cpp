@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_windows_test
+
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <nil/crypto3/multiprecision/cpp_int_modular.hpp>
+#include <boost/multiprecision/number.hpp>
+
+#include <nil/crypto3/marshalling/multiprecision/processing/windows.hpp>
+
+template<class T>
+T generate_random() {
+    static const unsigned limbs = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_bounded ?
+                                      std::numeric_limits<T>::digits / std::numeric_limits<unsigned>::digits + 3 :
+                                      20;
+
+    static boost::random::uniform_int_distribution<unsigned> ui(0, limbs);
+    static boost::random::mt19937 gen;
+    T val = gen();
+    unsigned lim = ui(gen);
+    for (unsigned i = 0; i < lim; ++i) {
+        val *= (gen.max)();
+        val += gen();
+    }
+    val.backend().normalize();
+
+    return val;
+}
+
+template<class T, std::size_t Window>
+void test_windows(const std::vector<T> &val_container) {
+    using namespace nil::crypto3::marshalling;
+
+    constexpr std::size_t count = processing::windows_count<Window, T>();
+    constexpr std::size_t signed_count = processing::signed_windows_count<Window, T>();
+    constexpr std::int32_t half = std::int32_t(1) << (Window - 1);
+
+    std::vector<std::uint16_t> digits(count * val_container.size());
+    std::vector<std::int16_t> signed_digits(signed_count * val_container.size());
+
+    BOOST_CHECK(processing::export_windows<Window>(val_container.begin(), val_container.end(), digits.data()) ==
+                digits.data() + digits.size());
+    BOOST_CHECK(processing::export_signed_windows<Window>(val_container.begin(), val_container.end(),
+                                                          signed_digits.data()) ==
+                signed_digits.data() + signed_digits.size());
+
+    T mask = (T(1) << Window) - 1;
+    for (std::size_t e = 0; e < val_container.size(); e++) {
+        std::int32_t carry = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            std::uint16_t digit = static_cast<std::uint16_t>(
+                static_cast<unsigned>((val_container[e] >> static_cast<unsigned>(i * Window)) & mask));
+            BOOST_CHECK_EQUAL(digits[e * count + i], digit);
+
+            std::int32_t signed_digit = signed_digits[e * signed_count + i];
+            BOOST_CHECK(signed_digit >= -half && signed_digit < half);
+
+            // digit + carry_in == signed_digit + carry_out * 2^Window
+            std::int32_t carry_out = (std::int32_t(digit) + carry - signed_digit) >> Window;
+            BOOST_CHECK(carry_out == 0 || carry_out == 1);
+            BOOST_CHECK_EQUAL(std::int32_t(digit) + carry, signed_digit + (carry_out << Window));
+            carry = carry_out;
+        }
+        BOOST_CHECK_EQUAL(std::int32_t(signed_digits[e * signed_count + count]), carry);
+    }
+}
+
+template<class T>
+void test_windows() {
+    std::vector<T> val_container;
+    for (std::size_t i = 0; i < 64; i++) {
+        val_container.push_back(generate_random<T>());
+    }
+    val_container.push_back(T(0));
+    val_container.push_back(~T(0));
+
+    test_windows<T, 2>(val_container);
+    test_windows<T, 4>(val_container);
+    test_windows<T, 5>(val_container);
+    test_windows<T, 13>(val_container);
+    test_windows<T, 16>(val_container);
+}
+
+BOOST_AUTO_TEST_SUITE(windows_test_suite)
+
+BOOST_AUTO_TEST_CASE(windows_cpp_uint512) {
+    test_windows<boost::multiprecision::uint512_modular_t>();
+}
+
+BOOST_AUTO_TEST_CASE(windows_cpp_int_backend_255) {
+    test_windows<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<255>>>();
+}
+
+BOOST_AUTO_TEST_CASE(windows_cpp_int_backend_23) {
+    test_windows<boost::multiprecision::number<boost::multiprecision::cpp_int_modular_backend<23>>>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()